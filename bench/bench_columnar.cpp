@@ -0,0 +1,87 @@
+#include "lunar_log.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+    minta::LogEntry makeEntry(int index) {
+        static const char *hosts[] = {"web1", "web2", "web3", "db1"};
+        minta::LogEntry entry;
+        entry.level = index % 50 == 0 ? minta::LogLevel::ERROR : minta::LogLevel::INFO;
+        entry.templateStr = index % 3 ? "Request {path} served in {ms} ms" : "User {username} logged in";
+        if (index % 3) {
+            entry.arguments = {{"path", "/api/orders"}, {"ms", std::to_string(index % 97)}};
+            entry.message = "Request /api/orders served in " + std::to_string(index % 97) + " ms";
+        } else {
+            entry.arguments = {{"username", "alice"}};
+            entry.message = "User alice logged in";
+        }
+        entry.timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000)) +
+                          std::chrono::microseconds(index * 250);
+        entry.line = 0;
+        entry.customContext = {{"host", hosts[index % 4]}, {"service", "checkout"}};
+        return entry;
+    }
+
+    double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    std::string readFile(const char *filename) {
+        std::ifstream file(filename, std::ios::binary);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+}
+
+int main(int argc, char **argv) {
+    const int entries = argc > 1 ? std::stoi(argv[1]) : 200000;
+    std::remove("bench_columnar.bin");
+    std::remove("bench_columnar.json");
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        minta::ColumnarSink sink("bench_columnar.bin");
+        for (int i = 0; i < entries; ++i) sink.write(makeEntry(i));
+    }
+    double columnarWriteMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    {
+        minta::StaticSink<minta::JsonFormatter, minta::FileTransport> sink("bench_columnar.json");
+        for (int i = 0; i < entries; ++i) sink.write(makeEntry(i));
+    }
+    double jsonWriteMs = elapsedMs(start);
+
+    std::string columnar = readFile("bench_columnar.bin");
+    std::string json = readFile("bench_columnar.json");
+    minta::ColumnarReader reader(columnar.data(), columnar.size());
+
+    size_t matched = 0;
+    start = std::chrono::steady_clock::now();
+    reader.scan(INT64_MIN, INT64_MAX, minta::LogLevel::TRACE, [&](const minta::LogEntry &) { ++matched; });
+    double fullScanMs = elapsedMs(start);
+
+    int64_t from = minta::toEpochNanos(makeEntry(entries / 2).timestamp);
+    int64_t to = minta::toEpochNanos(makeEntry(entries / 2 + 1000).timestamp);
+    size_t rangeMatched = 0;
+    start = std::chrono::steady_clock::now();
+    size_t decodedGroups = reader.scan(from, to, minta::LogLevel::TRACE, [&](const minta::LogEntry &) { ++rangeMatched; });
+    double rangeScanMs = elapsedMs(start);
+
+    std::remove("bench_columnar.bin");
+    std::remove("bench_columnar.json");
+
+    std::cout << "entries:                 " << entries << "\n"
+              << "columnar write:          " << columnarWriteMs << " ms, " << columnar.size() << " bytes\n"
+              << "json write:              " << jsonWriteMs << " ms, " << json.size() << " bytes\n"
+              << "full scan:               " << fullScanMs << " ms (" << matched << " rows)\n"
+              << "1000-entry range scan:   " << rangeScanMs << " ms (" << rangeMatched << " rows, "
+              << decodedGroups << " of " << reader.rowGroups().size() << " row groups decoded)\n";
+    return 0;
+}
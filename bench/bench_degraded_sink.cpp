@@ -0,0 +1,197 @@
+// Producer-side cost and memory growth while the only sink is degraded by a
+// FaultInjectingTransport. Producers log at a fixed rate; the report gives
+// caller latency percentiles, the queue high-water mark, drops, sink errors
+// and resident-memory growth for each scenario.
+//
+//   BenchDegradedSink [--scenario=NAME|all] [--threads=N] [--entries=N]
+//                     [--rate=CALLS_PER_SEC] [--max-queue=N] [--out=FILE]
+//
+// healthy: no faults
+// slow:    every write takes an extra 100 us
+// stalled: every 2000th write blocks for 200 ms
+// failing: every 50th write throws
+// partial: every 10th write is truncated to half its length
+//
+// --max-queue bounds the queue (0 = unbounded) to compare dropping against
+// unbounded growth.
+
+#include "bench_harness.hpp"
+#include "latency_histogram.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+    struct DegradedOptions {
+        DegradedOptions() : scenario("all"), threads(4), entries(20000), rate(20000), maxQueue(0) {
+        }
+
+        std::string scenario;
+        unsigned threads;
+        uint64_t entries;
+        uint64_t rate;
+        size_t maxQueue;
+        std::string out;
+    };
+
+    struct ScenarioResult {
+        bench::LatencyHistogram latency;
+        minta::LogStats stats;
+        int64_t rssGrowthBytes;
+        int64_t drainNs;
+    };
+
+    const char *const kScenarios[] = {"healthy", "slow", "stalled", "failing", "partial"};
+
+    minta::FaultOptions faultsFor(const std::string &scenario) {
+        minta::FaultOptions faults;
+        if (scenario == "slow") {
+            faults.latency = std::chrono::microseconds(100);
+        } else if (scenario == "stalled") {
+            faults.stallEvery = 2000;
+            faults.stallDuration = std::chrono::milliseconds(200);
+        } else if (scenario == "failing") {
+            faults.failEvery = 50;
+        } else if (scenario == "partial") {
+            faults.partialEvery = 10;
+        }
+        return faults;
+    }
+
+    // Resident set size from /proc; 0 where it is not available.
+    int64_t residentBytes() {
+        std::ifstream statm("/proc/self/statm");
+        int64_t pages = 0;
+        int64_t resident = 0;
+        if (!(statm >> pages >> resident)) {
+            return 0;
+        }
+        return resident * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    ScenarioResult runScenario(const std::string &scenario, const DegradedOptions &options) {
+        ScenarioResult result;
+        int64_t rssBefore = residentBytes();
+        std::chrono::steady_clock::time_point producersDone;
+        {
+            minta::LunarLog logger(minta::LogLevel::INFO, false);
+            logger.setRateLimit(0);
+            logger.setMaxQueueSize(options.maxQueue);
+            logger.addSink<bench::FaultySink>(faultsFor(scenario));
+
+            const std::chrono::nanoseconds interval(1000000000LL / static_cast<int64_t>(std::max<uint64_t>(1, options.rate)));
+            std::vector<bench::LatencyHistogram> histograms(options.threads);
+            std::vector<std::thread> threads;
+            std::atomic<unsigned> ready(0);
+
+            for (unsigned t = 0; t < options.threads; ++t) {
+                threads.emplace_back([&, t] {
+                    bench::LatencyHistogram &histogram = histograms[t];
+                    ++ready;
+                    while (ready < options.threads) {
+                        std::this_thread::yield();
+                    }
+                    auto next = std::chrono::steady_clock::now();
+                    for (uint64_t i = 0; i < options.entries; ++i) {
+                        std::this_thread::sleep_until(next);
+                        next += interval;
+                        auto start = std::chrono::steady_clock::now();
+                        logger.info("Request {id} handled by worker {worker}", i, t);
+                        histogram.record(static_cast<uint64_t>(bench::elapsedNs(start)));
+                    }
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            producersDone = std::chrono::steady_clock::now();
+            result.rssGrowthBytes = residentBytes() - rssBefore;
+            result.stats = logger.getStats();
+            for (const auto &histogram : histograms) {
+                result.latency.merge(histogram);
+            }
+        }
+        // The destructor drains the backlog the degraded sink left behind.
+        result.drainNs = bench::elapsedNs(producersDone);
+        return result;
+    }
+
+    bool parseOptions(int argc, char **argv, DegradedOptions &options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            size_t equals = arg.find('=');
+            std::string key = arg.substr(0, equals);
+            std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+            if (key == "--scenario") options.scenario = value;
+            else if (key == "--threads") options.threads = static_cast<unsigned>(std::max(1, std::atoi(value.c_str())));
+            else if (key == "--entries") options.entries = std::strtoull(value.c_str(), nullptr, 10);
+            else if (key == "--rate") options.rate = std::strtoull(value.c_str(), nullptr, 10);
+            else if (key == "--max-queue") options.maxQueue = static_cast<size_t>(std::strtoull(value.c_str(), nullptr, 10));
+            else if (key == "--out") options.out = value;
+            else return false;
+        }
+        if (options.scenario == "all") {
+            return true;
+        }
+        for (const char *scenario : kScenarios) {
+            if (options.scenario == scenario) return true;
+        }
+        return false;
+    }
+}
+
+int main(int argc, char **argv) {
+    DegradedOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0] << " [--scenario=healthy|slow|stalled|failing|partial|all] [--threads=N]"
+                  << " [--entries=N] [--rate=CALLS_PER_SEC] [--max-queue=N] [--out=FILE]\n";
+        return 2;
+    }
+
+    std::vector<std::string> scenarios;
+    if (options.scenario == "all") {
+        scenarios.assign(std::begin(kScenarios), std::end(kScenarios));
+    } else {
+        scenarios.push_back(options.scenario);
+    }
+
+    std::ostringstream json;
+    json << "{\n  \"suite\": \"degraded_sink\",\n"
+         << "  \"context\": {\"threads\": " << options.threads << ", \"entries_per_thread\": " << options.entries
+         << ", \"rate_per_thread\": " << options.rate << ", \"max_queue\": " << options.maxQueue << "},\n"
+         << "  \"scenarios\": [";
+    for (size_t s = 0; s < scenarios.size(); ++s) {
+        ScenarioResult result = runScenario(scenarios[s], options);
+        const minta::SinkStats &sink = result.stats.sinks.at(0);
+        json << (s ? ",\n" : "\n") << "    {\"scenario\": \"" << scenarios[s] << "\""
+             << ", \"p50_ns\": " << result.latency.percentile(50)
+             << ", \"p99_ns\": " << result.latency.percentile(99)
+             << ", \"p99_9_ns\": " << result.latency.percentile(99.9)
+             << ", \"max_ns\": " << result.latency.max()
+             << ", \"queue_high_water\": " << result.stats.queueHighWater
+             << ", \"dropped_overflow\": " << result.stats.droppedOverflow
+             << ", \"sink_errors\": " << sink.errors
+             << ", \"rss_growth_bytes\": " << result.rssGrowthBytes
+             << ", \"drain_ns\": " << result.drainNs << "}";
+
+        std::cerr << std::left << std::setw(10) << scenarios[s] << std::right
+                  << " p99 " << std::setw(10) << result.latency.percentile(99)
+                  << " max " << std::setw(10) << result.latency.max() << " ns"
+                  << "  queue hwm " << std::setw(8) << result.stats.queueHighWater
+                  << "  dropped " << std::setw(7) << result.stats.droppedOverflow
+                  << "  errors " << std::setw(6) << sink.errors
+                  << "  rss +" << result.rssGrowthBytes / 1024 << " KiB\n";
+    }
+    json << "\n  ]\n}\n";
+
+    if (options.out.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream(options.out) << json.str();
+    }
+    return 0;
+}
@@ -0,0 +1,168 @@
+#ifndef LUNAR_LOG_BENCH_HARNESS_HPP
+#define LUNAR_LOG_BENCH_HARNESS_HPP
+
+// Minimal self-contained benchmark harness: runs each case a few times, keeps
+// the median, and reports a table on stderr and JSON on stdout (or --out=FILE).
+
+#include "lunar_log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+    struct Options {
+        Options() : scale(1.0), repetitions(3) {
+        }
+
+        static Options parse(int argc, char **argv) {
+            Options options;
+            for (int i = 1; i < argc; ++i) {
+                std::string arg = argv[i];
+                if (arg.compare(0, 9, "--filter=") == 0) {
+                    options.filter = arg.substr(9);
+                } else if (arg.compare(0, 8, "--scale=") == 0) {
+                    options.scale = std::atof(arg.c_str() + 8);
+                } else if (arg.compare(0, 14, "--repetitions=") == 0) {
+                    options.repetitions = std::max(1, std::atoi(arg.c_str() + 14));
+                } else if (arg.compare(0, 6, "--out=") == 0) {
+                    options.out = arg.substr(6);
+                } else {
+                    std::cerr << "usage: " << argv[0]
+                              << " [--filter=SUBSTRING] [--scale=FACTOR] [--repetitions=N] [--out=FILE]\n";
+                    std::exit(2);
+                }
+            }
+            return options;
+        }
+
+        bool selected(const std::string &name) const {
+            return filter.empty() || name.find(filter) != std::string::npos;
+        }
+
+        uint64_t iterations(uint64_t base) const {
+            return std::max<uint64_t>(1, static_cast<uint64_t>(static_cast<double>(base) * scale));
+        }
+
+        std::string filter;
+        double scale;
+        int repetitions;
+        std::string out;
+    };
+
+    struct Result {
+        std::string name;
+        uint64_t iterations;
+        double nsPerOp;
+        std::vector<std::pair<std::string, double> > metrics;
+    };
+
+    class Reporter {
+    public:
+        explicit Reporter(const Options &options) : m_options(options) {
+        }
+
+        // `run` performs `iterations` operations and returns the elapsed nanoseconds
+        // that should count; the median over the configured repetitions is kept.
+        template<typename Run>
+        Result &measure(const std::string &name, uint64_t iterations, Run run) {
+            std::vector<double> samples;
+            for (int i = 0; i < m_options.repetitions; ++i) {
+                samples.push_back(static_cast<double>(run(iterations)) / static_cast<double>(iterations));
+            }
+            std::sort(samples.begin(), samples.end());
+
+            Result result;
+            result.name = name;
+            result.iterations = iterations;
+            result.nsPerOp = samples[samples.size() / 2];
+            m_results.push_back(result);
+            std::cerr << std::left << std::setw(40) << name << std::right << std::setw(12) << std::fixed
+                      << std::setprecision(1) << result.nsPerOp << " ns/op" << std::setw(14) << std::setprecision(0)
+                      << 1e9 / result.nsPerOp << " ops/s\n";
+            return m_results.back();
+        }
+
+        bool selected(const std::string &name) const {
+            return m_options.selected(name);
+        }
+
+        void writeJson(const std::string &suite) const {
+            std::ofstream file;
+            if (!m_options.out.empty()) {
+                file.open(m_options.out);
+            }
+            std::ostream &out = m_options.out.empty() ? std::cout : file;
+
+            out << "{\n  \"suite\": \"" << suite << "\",\n"
+                << "  \"context\": {\"cplusplus\": " << __cplusplus
+                << ", \"hardware_concurrency\": " << std::thread::hardware_concurrency()
+                << ", \"scale\": " << m_options.scale
+                << ", \"repetitions\": " << m_options.repetitions << "},\n"
+                << "  \"benchmarks\": [";
+            for (size_t i = 0; i < m_results.size(); ++i) {
+                const Result &result = m_results[i];
+                out << (i ? ",\n" : "\n") << "    {\"name\": \"" << result.name << "\""
+                    << ", \"iterations\": " << result.iterations
+                    << std::fixed << std::setprecision(3)
+                    << ", \"ns_per_op\": " << result.nsPerOp
+                    << ", \"ops_per_sec\": " << 1e9 / result.nsPerOp;
+                for (const auto &metric : result.metrics) {
+                    out << ", \"" << metric.first << "\": " << metric.second;
+                }
+                out << "}";
+            }
+            out << "\n  ]\n}\n";
+        }
+
+    private:
+        Options m_options;
+        std::vector<Result> m_results;
+    };
+
+    // Formats with HumanReadableFormatter and writes through a FaultInjectingTransport
+    // wrapped around a NullTransport, so only the injected faults cost time.
+    class FaultySink : public minta::ISink {
+    public:
+        explicit FaultySink(const minta::FaultOptions &options) {
+            setFormatter(minta::make_unique<minta::HumanReadableFormatter>());
+            setTransport(minta::make_unique<minta::FaultInjectingTransport>(
+                minta::make_unique<minta::NullTransport>(), options));
+        }
+
+        void write(const minta::LogEntry &entry) override {
+            m_transport->write(m_formatter->format(entry));
+        }
+
+        bool acceptsFormattedOutput() const override {
+            return true;
+        }
+    };
+
+    inline int64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    inline minta::LogEntry makeEntry() {
+        minta::LogEntry entry;
+        entry.level = minta::LogLevel::INFO;
+        entry.message = "User alice logged in from 192.168.1.1";
+        entry.timestamp = std::chrono::system_clock::now();
+        entry.templateStr = "User {username} logged in from {ip}";
+        entry.arguments = {{"username", "alice"}, {"ip", "192.168.1.1"}};
+        entry.file = "service.cpp";
+        entry.line = 42;
+        entry.function = "handleLogin";
+        entry.customContext = {{"session_id", "abc123"}, {"tenant", "acme"}};
+        entry.threadId = std::this_thread::get_id();
+        return entry;
+    }
+} // namespace bench
+
+#endif // LUNAR_LOG_BENCH_HARNESS_HPP
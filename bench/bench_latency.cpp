@@ -0,0 +1,152 @@
+// Caller-side latency of LunarLog calls under different load shapes. Every
+// call is timed with steady_clock and recorded in a per-thread histogram;
+// the report gives p50/p99/p99.9/max per thread and overall.
+//
+//   BenchLatency [--shape=steady|bursty|stalled|all] [--threads=N] [--entries=N]
+//                [--rate=CALLS_PER_SEC] [--burst=N] [--out=FILE]
+//
+// steady:  each thread paces its calls at --rate
+// bursty:  each thread issues --burst calls back to back, then idles for the
+//          time the burst would take at --rate
+// stalled: steady load while the sink blocks for 50 ms every 1000 writes
+
+#include "bench_harness.hpp"
+#include "latency_histogram.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct LatencyOptions {
+        LatencyOptions() : shape("all"), threads(4), entries(20000), rate(20000), burst(500) {
+        }
+
+        std::string shape;
+        unsigned threads;
+        uint64_t entries;
+        uint64_t rate;
+        uint64_t burst;
+        std::string out;
+    };
+
+    std::vector<bench::LatencyHistogram> runShape(const std::string &shape, const LatencyOptions &options) {
+        minta::LunarLog logger(minta::LogLevel::INFO, false);
+        logger.setRateLimit(0);
+        if (shape == "stalled") {
+            minta::FaultOptions faults;
+            faults.stallEvery = 1000;
+            faults.stallDuration = std::chrono::milliseconds(50);
+            logger.addSink<bench::FaultySink>(faults);
+        } else {
+            logger.addSink<minta::NullSink>();
+        }
+
+        const std::chrono::nanoseconds interval(1000000000LL / static_cast<int64_t>(std::max<uint64_t>(1, options.rate)));
+        const uint64_t burst = shape == "bursty" ? options.burst : 1;
+        std::vector<bench::LatencyHistogram> histograms(options.threads);
+        std::vector<std::thread> threads;
+        std::atomic<unsigned> ready(0);
+
+        for (unsigned t = 0; t < options.threads; ++t) {
+            threads.emplace_back([&, t] {
+                bench::LatencyHistogram &histogram = histograms[t];
+                ++ready;
+                while (ready < options.threads) {
+                    std::this_thread::yield();
+                }
+                auto next = std::chrono::steady_clock::now();
+                for (uint64_t i = 0; i < options.entries; ++i) {
+                    if (i % burst == 0) {
+                        std::this_thread::sleep_until(next);
+                        next += interval * static_cast<int64_t>(burst);
+                    }
+                    auto start = std::chrono::steady_clock::now();
+                    logger.info("Request {id} handled by worker {worker}", i, t);
+                    histogram.record(static_cast<uint64_t>(bench::elapsedNs(start)));
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        return histograms;
+    }
+
+    void writeSummary(std::ostream &out, const bench::LatencyHistogram &histogram) {
+        out << "{\"count\": " << histogram.count()
+            << ", \"p50_ns\": " << histogram.percentile(50)
+            << ", \"p99_ns\": " << histogram.percentile(99)
+            << ", \"p99_9_ns\": " << histogram.percentile(99.9)
+            << ", \"max_ns\": " << histogram.max() << "}";
+    }
+
+    bool parseOptions(int argc, char **argv, LatencyOptions &options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            size_t equals = arg.find('=');
+            std::string key = arg.substr(0, equals);
+            std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+            if (key == "--shape") options.shape = value;
+            else if (key == "--threads") options.threads = static_cast<unsigned>(std::max(1, std::atoi(value.c_str())));
+            else if (key == "--entries") options.entries = std::strtoull(value.c_str(), nullptr, 10);
+            else if (key == "--rate") options.rate = std::strtoull(value.c_str(), nullptr, 10);
+            else if (key == "--burst") options.burst = std::max<uint64_t>(1, std::strtoull(value.c_str(), nullptr, 10));
+            else if (key == "--out") options.out = value;
+            else return false;
+        }
+        return options.shape == "all" || options.shape == "steady" || options.shape == "bursty" ||
+               options.shape == "stalled";
+    }
+}
+
+int main(int argc, char **argv) {
+    LatencyOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0] << " [--shape=steady|bursty|stalled|all] [--threads=N] [--entries=N]"
+                  << " [--rate=CALLS_PER_SEC] [--burst=N] [--out=FILE]\n";
+        return 2;
+    }
+
+    std::vector<std::string> shapes;
+    if (options.shape == "all") {
+        shapes = {"steady", "bursty", "stalled"};
+    } else {
+        shapes.push_back(options.shape);
+    }
+
+    std::ostringstream json;
+    json << "{\n  \"suite\": \"latency\",\n"
+         << "  \"context\": {\"threads\": " << options.threads << ", \"entries_per_thread\": " << options.entries
+         << ", \"rate_per_thread\": " << options.rate << ", \"burst\": " << options.burst << "},\n"
+         << "  \"shapes\": [";
+    for (size_t s = 0; s < shapes.size(); ++s) {
+        std::vector<bench::LatencyHistogram> histograms = runShape(shapes[s], options);
+        bench::LatencyHistogram overall;
+        json << (s ? ",\n" : "\n") << "    {\"shape\": \"" << shapes[s] << "\", \"threads\": [";
+        for (size_t t = 0; t < histograms.size(); ++t) {
+            overall.merge(histograms[t]);
+            json << (t ? ", " : "");
+            writeSummary(json, histograms[t]);
+        }
+        json << "],\n     \"overall\": ";
+        writeSummary(json, overall);
+        json << "}";
+
+        std::cerr << std::left << std::setw(10) << shapes[s] << std::right
+                  << " p50 " << std::setw(10) << overall.percentile(50)
+                  << " p99 " << std::setw(10) << overall.percentile(99)
+                  << " p99.9 " << std::setw(10) << overall.percentile(99.9)
+                  << " max " << std::setw(10) << overall.max() << " ns\n";
+    }
+    json << "\n  ]\n}\n";
+
+    if (options.out.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream(options.out) << json.str();
+    }
+    return 0;
+}
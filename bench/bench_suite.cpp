@@ -0,0 +1,201 @@
+// Benchmarks for the whole logging pipeline: caller-side cost of LunarLog calls,
+// end-to-end throughput by producer count, each formatter, each transport and
+// worker-side dispatch across many sinks.
+//
+//   BenchSuite [--filter=SUBSTRING] [--scale=FACTOR] [--repetitions=N] [--out=FILE]
+
+#include "bench_harness.hpp"
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::unique_ptr<minta::LunarLog> makeLogger(minta::LogLevel level = minta::LogLevel::INFO) {
+        std::unique_ptr<minta::LunarLog> logger = minta::make_unique<minta::LunarLog>(level, false);
+        logger->setRateLimit(0);
+        logger->addSink<minta::NullSink>();
+        return logger;
+    }
+
+    // Times only the calls; draining the queue happens when the logger is destroyed.
+    template<typename Call>
+    void benchCall(bench::Reporter &reporter, const std::string &name, uint64_t iterations, Call call,
+                   bool captureContext = false, size_t contextKeys = 0) {
+        if (!reporter.selected(name)) return;
+        reporter.measure(name, iterations, [&](uint64_t count) {
+            std::unique_ptr<minta::LunarLog> logger = makeLogger();
+            logger->setCaptureContext(captureContext);
+            for (size_t i = 0; i < contextKeys; ++i) {
+                logger->setContext("key" + std::to_string(i), "value" + std::to_string(i));
+            }
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < count; ++i) {
+                call(*logger, i);
+            }
+            return bench::elapsedNs(start);
+        });
+    }
+
+    void benchCalls(bench::Reporter &reporter, const bench::Options &options) {
+        const uint64_t iterations = options.iterations(100000);
+        benchCall(reporter, "call/no_args", iterations, [](minta::LunarLog &logger, uint64_t) {
+            logger.info("Service started");
+        });
+        benchCall(reporter, "call/int_arg", iterations, [](minta::LunarLog &logger, uint64_t i) {
+            logger.info("Processed item {index}", i);
+        });
+        benchCall(reporter, "call/mixed_args", iterations, [](minta::LunarLog &logger, uint64_t i) {
+            logger.info("User {username} paid {amount} for order {order}", "alice", 12.5, i);
+        });
+        benchCall(reporter, "call/below_min_level", iterations * 10, [](minta::LunarLog &logger, uint64_t i) {
+            logger.debug("Processed item {index}", i);
+        });
+        benchCall(reporter, "call/placeholder_warnings", iterations, [](minta::LunarLog &logger, uint64_t i) {
+            logger.info("Repeated {value} and {value}", i);
+        });
+        benchCall(reporter, "call/source_location", iterations, [](minta::LunarLog &logger, uint64_t i) {
+            logger.logWithContext(minta::LogLevel::INFO, __FILE__, __LINE__, __func__, "Processed item {index}", i);
+        }, true);
+        benchCall(reporter, "call/custom_context_4", iterations, [](minta::LunarLog &logger, uint64_t i) {
+            logger.info("Processed item {index}", i);
+        }, false, 4);
+    }
+
+    // Measures from the first call until every entry has been written.
+    void benchThroughput(bench::Reporter &reporter, const bench::Options &options) {
+        const uint64_t total = options.iterations(200000);
+        const unsigned producerCounts[] = {1, 2, 4, 8};
+        for (unsigned producers : producerCounts) {
+            std::string name = "throughput/producers_" + std::to_string(producers);
+            if (!reporter.selected(name)) continue;
+            reporter.measure(name, total, [producers](uint64_t count) {
+                std::unique_ptr<minta::LunarLog> logger = makeLogger();
+                auto start = std::chrono::steady_clock::now();
+                std::vector<std::thread> threads;
+                for (unsigned t = 0; t < producers; ++t) {
+                    threads.emplace_back([&logger, count, producers, t] {
+                        for (uint64_t i = t; i < count; i += producers) {
+                            logger->info("Processed item {index} on {thread}", i, t);
+                        }
+                    });
+                }
+                for (auto &thread : threads) {
+                    thread.join();
+                }
+                logger.reset();
+                return bench::elapsedNs(start);
+            });
+        }
+    }
+
+    void benchFormatter(bench::Reporter &reporter, const bench::Options &options, const std::string &name,
+                        const minta::IFormatter &formatter) {
+        if (!reporter.selected(name)) return;
+        const minta::LogEntry entry = bench::makeEntry();
+        reporter.measure(name, options.iterations(200000), [&](uint64_t count) {
+            size_t bytes = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < count; ++i) {
+                bytes += formatter.format(entry).size();
+            }
+            int64_t elapsed = bench::elapsedNs(start);
+            if (bytes == 0) std::abort();
+            return elapsed;
+        });
+    }
+
+    void benchFormatters(bench::Reporter &reporter, const bench::Options &options) {
+        benchFormatter(reporter, options, "formatter/human", minta::HumanReadableFormatter());
+        benchFormatter(reporter, options, "formatter/json", minta::JsonFormatter());
+        benchFormatter(reporter, options, "formatter/xml", minta::XmlFormatter());
+        benchFormatter(reporter, options, "formatter/logfmt", minta::LogfmtFormatter());
+        benchFormatter(reporter, options, "formatter/msgpack", minta::MsgPackFormatter());
+        benchFormatter(reporter, options, "formatter/binary", minta::BinaryFormatter());
+        benchFormatter(reporter, options, "formatter/pattern",
+                       minta::PatternFormatter("%Y-%m-%dT%H:%M:%S.%f %l [%t] %s:%# %v %ctx"));
+    }
+
+    template<typename MakeTransport>
+    void benchTransport(bench::Reporter &reporter, const bench::Options &options, const std::string &name,
+                        const char *filename, MakeTransport makeTransport) {
+        if (!reporter.selected(name)) return;
+        const std::string formatted = minta::JsonFormatter().format(bench::makeEntry());
+        reporter.measure(name, options.iterations(100000), [&](uint64_t count) {
+            if (filename) std::remove(filename);
+            int64_t elapsed;
+            {
+                std::unique_ptr<minta::ITransport> transport = makeTransport();
+                auto start = std::chrono::steady_clock::now();
+                for (uint64_t i = 0; i < count; ++i) {
+                    transport->write(formatted);
+                }
+                transport.reset();
+                elapsed = bench::elapsedNs(start);
+            }
+            if (filename) std::remove(filename);
+            return elapsed;
+        });
+    }
+
+    void benchTransports(bench::Reporter &reporter, const bench::Options &options) {
+        benchTransport(reporter, options, "transport/null", nullptr, [] {
+            return std::unique_ptr<minta::ITransport>(minta::make_unique<minta::NullTransport>());
+        });
+        benchTransport(reporter, options, "transport/file", "bench_suite_file.log", [] {
+            return std::unique_ptr<minta::ITransport>(minta::make_unique<minta::FileTransport>("bench_suite_file.log"));
+        });
+        benchTransport(reporter, options, "transport/binary_file", "bench_suite_binary.bin", [] {
+            return std::unique_ptr<minta::ITransport>(minta::make_unique<minta::BinaryFileTransport>("bench_suite_binary.bin"));
+        });
+        benchTransport(reporter, options, "transport/framed_file", "bench_suite_framed.bin", [] {
+            return std::unique_ptr<minta::ITransport>(minta::make_unique<minta::FramedFileTransport>("bench_suite_framed.bin"));
+        });
+    }
+
+    // 16 sinks of which only two accept the entry, routed either by level or by tag.
+    void benchDispatch(bench::Reporter &reporter, const bench::Options &options, const std::string &name, bool byTag) {
+        if (!reporter.selected(name)) return;
+        minta::LogManager manager;
+        for (int i = 0; i < 16; ++i) {
+            minta::SinkId id = manager.addSink(minta::make_unique<minta::NullSink>());
+            if (i < 2) continue;
+            if (byTag) {
+                manager.setSinkTags(id, {"audit"});
+            } else {
+                manager.setSinkMinLevel(id, minta::LogLevel::ERROR);
+            }
+        }
+        const minta::LogEntry entry = bench::makeEntry();
+        reporter.measure(name, options.iterations(200000), [&](uint64_t count) {
+            std::shared_ptr<const minta::LogManager::Snapshot> sinks = manager.snapshot();
+            uint64_t bytes = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < count; ++i) {
+                bytes += manager.log(*sinks, entry);
+            }
+            int64_t elapsed = bench::elapsedNs(start);
+            if (bytes == 0) std::abort();
+            return elapsed;
+        });
+    }
+
+    void benchDispatches(bench::Reporter &reporter, const bench::Options &options) {
+        benchDispatch(reporter, options, "dispatch/16_sinks_by_level", false);
+        benchDispatch(reporter, options, "dispatch/16_sinks_by_tag", true);
+    }
+}
+
+int main(int argc, char **argv) {
+    bench::Options options = bench::Options::parse(argc, argv);
+    bench::Reporter reporter(options);
+
+    benchCalls(reporter, options);
+    benchThroughput(reporter, options);
+    benchFormatters(reporter, options);
+    benchTransports(reporter, options);
+    benchDispatches(reporter, options);
+
+    reporter.writeJson("pipeline");
+    return 0;
+}
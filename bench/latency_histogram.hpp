@@ -0,0 +1,95 @@
+#ifndef LUNAR_LOG_BENCH_LATENCY_HISTOGRAM_HPP
+#define LUNAR_LOG_BENCH_LATENCY_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace bench {
+    // Log-linear histogram in the style of HdrHistogram: values below 64 are
+    // exact, larger values fall into 32 sub-buckets per power of two, so any
+    // recorded value is reported within about 3%. Not thread-safe; keep one per
+    // thread and merge them afterwards.
+    class LatencyHistogram {
+    public:
+        LatencyHistogram() : m_counts(bucketCount(), 0), m_total(0), m_max(0) {
+        }
+
+        void record(uint64_t value) {
+            ++m_counts[bucketIndex(value)];
+            ++m_total;
+            m_max = std::max(m_max, value);
+        }
+
+        void merge(const LatencyHistogram &other) {
+            for (size_t i = 0; i < m_counts.size(); ++i) {
+                m_counts[i] += other.m_counts[i];
+            }
+            m_total += other.m_total;
+            m_max = std::max(m_max, other.m_max);
+        }
+
+        uint64_t count() const {
+            return m_total;
+        }
+
+        uint64_t max() const {
+            return m_max;
+        }
+
+        // Upper bound of the bucket holding the given percentile (0-100).
+        uint64_t percentile(double percent) const {
+            if (m_total == 0) {
+                return 0;
+            }
+            uint64_t rank = static_cast<uint64_t>(percent / 100.0 * static_cast<double>(m_total) + 0.5);
+            rank = std::max<uint64_t>(1, std::min(rank, m_total));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < m_counts.size(); ++i) {
+                seen += m_counts[i];
+                if (seen >= rank) {
+                    return std::min(bucketUpperBound(i), m_max);
+                }
+            }
+            return m_max;
+        }
+
+        static size_t bucketIndex(uint64_t value) {
+            if (value < 2 * SubBuckets) {
+                return static_cast<size_t>(value);
+            }
+            int exponent = highestBit(value) - SubBucketBits;
+            return static_cast<size_t>(exponent) * SubBuckets + static_cast<size_t>(value >> exponent);
+        }
+
+        static uint64_t bucketUpperBound(size_t index) {
+            if (index < 2 * SubBuckets) {
+                return index;
+            }
+            size_t exponent = index / SubBuckets - 1;
+            uint64_t mantissa = index - exponent * SubBuckets;
+            return ((mantissa + 1) << exponent) - 1;
+        }
+
+    private:
+        enum { SubBucketBits = 5, SubBuckets = 1 << SubBucketBits };
+
+        std::vector<uint64_t> m_counts;
+        uint64_t m_total;
+        uint64_t m_max;
+
+        static size_t bucketCount() {
+            return (64 - SubBucketBits) * SubBuckets + SubBuckets;
+        }
+
+        static int highestBit(uint64_t value) {
+            int bit = 0;
+            while (value >>= 1) {
+                ++bit;
+            }
+            return bit;
+        }
+    };
+} // namespace bench
+
+#endif // LUNAR_LOG_BENCH_LATENCY_HISTOGRAM_HPP
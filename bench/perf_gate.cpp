@@ -0,0 +1,204 @@
+// Performance regression gate, registered with ctest as PerfGate. Logs a
+// fixed workload of INFO entries through JsonFormatter to a NullSink and
+// compares end-to-end throughput and allocations per entry against the
+// committed baseline in bench/perf_baseline.json.
+//
+//   PerfGate --baseline=FILE [--entries=N] [--runs=N] [--update]
+//
+// The check fails when throughput drops below (1 - throughput_tolerance) of
+// the baseline or allocations per entry grow beyond allocation_tolerance.
+// Throughput is only compared when the build's optimization setting matches
+// the one the baseline was recorded with. --update rewrites the baseline
+// with the current measurements.
+
+#include "lunar_log.hpp"
+#include "allocation_counter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+#ifdef __OPTIMIZE__
+    const bool kOptimized = true;
+#else
+    const bool kOptimized = false;
+#endif
+
+    struct Measurement {
+        double entriesPerSec;
+        double allocationsPerEntry;
+    };
+
+    struct Baseline {
+        Baseline() : entries(100000), optimized(false), entriesPerSec(0), allocationsPerEntry(0),
+                     throughputTolerance(0.5), allocationTolerance(0.1) {
+        }
+
+        uint64_t entries;
+        bool optimized;
+        double entriesPerSec;
+        double allocationsPerEntry;
+        double throughputTolerance;
+        double allocationTolerance;
+    };
+
+    // The baseline is a flat JSON object of numbers, so a key lookup is enough.
+    bool readNumber(const std::string &json, const std::string &key, double &value) {
+        size_t pos = json.find("\"" + key + "\"");
+        if (pos == std::string::npos) return false;
+        pos = json.find(':', pos);
+        if (pos == std::string::npos) return false;
+        const char *start = json.c_str() + pos + 1;
+        char *end = nullptr;
+        value = std::strtod(start, &end);
+        return end != start;
+    }
+
+    bool loadBaseline(const std::string &path, Baseline &baseline) {
+        std::ifstream file(path);
+        if (!file) return false;
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string json = buffer.str();
+
+        double entries = 0;
+        double optimized = 0;
+        if (!readNumber(json, "entries", entries) || !readNumber(json, "optimized", optimized) ||
+            !readNumber(json, "entries_per_sec", baseline.entriesPerSec) ||
+            !readNumber(json, "allocations_per_entry", baseline.allocationsPerEntry)) {
+            return false;
+        }
+        baseline.entries = static_cast<uint64_t>(entries);
+        baseline.optimized = optimized != 0;
+        readNumber(json, "throughput_tolerance", baseline.throughputTolerance);
+        readNumber(json, "allocation_tolerance", baseline.allocationTolerance);
+        return true;
+    }
+
+    bool saveBaseline(const std::string &path, const Baseline &baseline) {
+        std::ofstream file(path);
+        file << std::fixed << std::setprecision(2)
+             << "{\n"
+             << "  \"workload\": \"info_json_null_sink\",\n"
+             << "  \"entries\": " << baseline.entries << ",\n"
+             << "  \"optimized\": " << (baseline.optimized ? 1 : 0) << ",\n"
+             << "  \"entries_per_sec\": " << baseline.entriesPerSec << ",\n"
+             << "  \"allocations_per_entry\": " << baseline.allocationsPerEntry << ",\n"
+             << "  \"throughput_tolerance\": " << baseline.throughputTolerance << ",\n"
+             << "  \"allocation_tolerance\": " << baseline.allocationTolerance << "\n"
+             << "}\n";
+        return static_cast<bool>(file);
+    }
+
+    // Time from the first call until the destructor has drained the queue.
+    Measurement runWorkload(uint64_t entries) {
+        uint64_t allocationsBefore = AllocationCounter::totalAllocations();
+        auto start = std::chrono::steady_clock::now();
+        {
+            minta::LunarLog logger(minta::LogLevel::INFO, false);
+            logger.setRateLimit(0);
+            logger.addSink<minta::NullSink, minta::JsonFormatter>();
+            for (uint64_t i = 0; i < entries; ++i) {
+                logger.info("User {username} completed order {orderId} in {elapsed} ms", "alice", i, 12.5);
+            }
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        uint64_t allocations = AllocationCounter::totalAllocations() - allocationsBefore;
+
+        Measurement measurement;
+        measurement.entriesPerSec = static_cast<double>(entries) / elapsed;
+        measurement.allocationsPerEntry = static_cast<double>(allocations) / static_cast<double>(entries);
+        return measurement;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string baselinePath;
+    uint64_t entries = 0;
+    int runs = 3;
+    bool update = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 11, "--baseline=") == 0) {
+            baselinePath = arg.substr(11);
+        } else if (arg.compare(0, 10, "--entries=") == 0) {
+            entries = std::strtoull(arg.c_str() + 10, nullptr, 10);
+        } else if (arg.compare(0, 7, "--runs=") == 0) {
+            runs = std::max(1, std::atoi(arg.c_str() + 7));
+        } else if (arg == "--update") {
+            update = true;
+        } else {
+            baselinePath.clear();
+            break;
+        }
+    }
+    if (baselinePath.empty()) {
+        std::cerr << "usage: " << argv[0] << " --baseline=FILE [--entries=N] [--runs=N] [--update]\n";
+        return 2;
+    }
+
+    Baseline baseline;
+    bool haveBaseline = loadBaseline(baselinePath, baseline);
+    if (!haveBaseline && !update) {
+        std::cerr << "cannot read baseline " << baselinePath << "\n";
+        return 2;
+    }
+    if (entries == 0) {
+        entries = baseline.entries;
+    }
+
+    runWorkload(std::min<uint64_t>(entries, 10000));
+    // Best throughput over the runs filters out scheduler noise; allocations
+    // are the same on every run.
+    Measurement best = runWorkload(entries);
+    for (int i = 1; i < runs; ++i) {
+        Measurement measurement = runWorkload(entries);
+        best.entriesPerSec = std::max(best.entriesPerSec, measurement.entriesPerSec);
+        best.allocationsPerEntry = std::min(best.allocationsPerEntry, measurement.allocationsPerEntry);
+    }
+
+    if (update) {
+        baseline.entries = entries;
+        baseline.optimized = kOptimized;
+        baseline.entriesPerSec = best.entriesPerSec;
+        baseline.allocationsPerEntry = best.allocationsPerEntry;
+        if (!saveBaseline(baselinePath, baseline)) {
+            std::cerr << "cannot write baseline " << baselinePath << "\n";
+            return 2;
+        }
+        std::cout << "baseline updated: " << std::fixed << std::setprecision(2) << best.entriesPerSec
+                  << " entries/s, " << best.allocationsPerEntry << " allocations/entry\n";
+        return 0;
+    }
+
+    bool passed = true;
+    double throughputRatio = best.entriesPerSec / baseline.entriesPerSec;
+    std::cout << std::fixed << std::setprecision(2)
+              << "throughput: " << best.entriesPerSec << " entries/s, baseline " << baseline.entriesPerSec
+              << ", ratio " << throughputRatio;
+    if (baseline.optimized != kOptimized) {
+        std::cout << " (not compared: baseline was recorded with "
+                  << (baseline.optimized ? "an optimized" : "an unoptimized") << " build)\n";
+    } else if (throughputRatio < 1.0 - baseline.throughputTolerance) {
+        std::cout << " REGRESSION (minimum ratio " << 1.0 - baseline.throughputTolerance << ")\n";
+        passed = false;
+    } else {
+        std::cout << "\n";
+    }
+
+    double allocationLimit = baseline.allocationsPerEntry * (1.0 + baseline.allocationTolerance);
+    std::cout << "allocations: " << best.allocationsPerEntry << " per entry, baseline "
+              << baseline.allocationsPerEntry;
+    if (best.allocationsPerEntry > allocationLimit) {
+        std::cout << " REGRESSION (limit " << allocationLimit << ")\n";
+        passed = false;
+    } else {
+        std::cout << "\n";
+    }
+    return passed ? 0 : 1;
+}
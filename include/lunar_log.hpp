@@ -4,18 +4,47 @@
 #include "lunar_log/core/log_common.hpp"
 #include "lunar_log/core/log_entry.hpp"
 #include "lunar_log/core/log_level.hpp"
+#include "lunar_log/core/binary_codec.hpp"
+#include "lunar_log/core/crc32c.hpp"
+#include "lunar_log/core/log_stats.hpp"
+#include "lunar_log/core/template_profiler.hpp"
+#include "lunar_log/core/log_filter.hpp"
+#include "lunar_log/core/backtrace_buffer.hpp"
 #include "lunar_log/formatter/formatter_interface.hpp"
 #include "lunar_log/formatter/human_readable_formatter.hpp"
 #include "lunar_log/formatter/json_formatter.hpp"
 #include "lunar_log/formatter/xml_formatter.hpp"
+#include "lunar_log/formatter/pattern_formatter.hpp"
+#include "lunar_log/formatter/binary_formatter.hpp"
+#include "lunar_log/formatter/msgpack_formatter.hpp"
+#include "lunar_log/formatter/logfmt_formatter.hpp"
 #include "lunar_log/transport/transport_interface.hpp"
 #include "lunar_log/transport/file_transport.hpp"
 #include "lunar_log/transport/stdout_transport.hpp"
+#include "lunar_log/transport/binary_file_transport.hpp"
+#include "lunar_log/transport/framed_file_transport.hpp"
+#include "lunar_log/transport/null_transport.hpp"
+#include "lunar_log/transport/fault_injecting_transport.hpp"
 #include "lunar_log/sink/sink_interface.hpp"
 #include "lunar_log/sink/console_sink.hpp"
+#include "lunar_log/sink/file_index_writer.hpp"
 #include "lunar_log/sink/file_sink.hpp"
+#include "lunar_log/sink/static_sink.hpp"
+#include "lunar_log/sink/binary_file_sink.hpp"
+#include "lunar_log/sink/columnar_sink.hpp"
+#include "lunar_log/sink/framed_file_sink.hpp"
+#include "lunar_log/sink/null_sink.hpp"
+#include "lunar_log/sink/memory_sink.hpp"
 #include "lunar_log/log_manager.hpp"
 #include "lunar_log/log_source.hpp"
+#include "lunar_log/reader/binary_log_reader.hpp"
+#include "lunar_log/reader/columnar_reader.hpp"
+#include "lunar_log/reader/framed_log_reader.hpp"
+#include "lunar_log/reader/mapped_file.hpp"
+#include "lunar_log/reader/log_line.hpp"
+#include "lunar_log/reader/file_index.hpp"
+#include "lunar_log/reader/log_query.hpp"
+#include "lunar_log/reader/log_merger.hpp"
 
 #define LUNAR_LOG_CONTEXT __FILE__, __LINE__, __FUNCTION__
 
@@ -0,0 +1,98 @@
+#ifndef LUNAR_LOG_BACKTRACE_BUFFER_HPP
+#define LUNAR_LOG_BACKTRACE_BUFFER_HPP
+
+#include "log_level.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace minta {
+    // An unrendered log call: the template and its converted values.
+    struct BacktraceRecord {
+        LogLevel level;
+        std::chrono::system_clock::time_point timestamp;
+        std::string templateStr;
+        std::vector<std::string> values;
+        std::string file;
+        int line;
+        std::string function;
+        std::thread::id threadId;
+        std::string tag;
+        std::map<std::string, std::string> customContext;
+    };
+
+    // Fixed-size ring of the most recent records; once full, each push
+    // overwrites the oldest record and reuses its buffers.
+    class BacktraceBuffer {
+    public:
+        BacktraceBuffer() : m_capacity(0), m_next(0), m_size(0) {
+        }
+
+        // Drops any buffered records; 0 disables the buffer.
+        void setCapacity(size_t capacity) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_records.clear();
+            m_records.resize(capacity);
+            m_next = 0;
+            m_size = 0;
+            m_capacity.store(capacity, std::memory_order_relaxed);
+        }
+
+        size_t capacity() const {
+            return m_capacity.load(std::memory_order_relaxed);
+        }
+
+        // Takes ownership of `values` and `context` by swapping them with the slot's old ones.
+        void push(LogLevel level, const char *tag, const char *file, int line, const char *function,
+                  const std::string &templateStr, std::vector<std::string> &values,
+                  std::map<std::string, std::string> &context) {
+            auto now = std::chrono::system_clock::now();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_records.empty()) {
+                return;
+            }
+            BacktraceRecord &record = m_records[m_next];
+            record.level = level;
+            record.timestamp = now;
+            record.templateStr.assign(templateStr);
+            record.values.swap(values);
+            record.file.assign(file);
+            record.line = line;
+            record.function.assign(function);
+            record.threadId = std::this_thread::get_id();
+            record.tag.assign(tag);
+            record.customContext.swap(context);
+            m_next = (m_next + 1) % m_records.size();
+            if (m_size < m_records.size()) {
+                ++m_size;
+            }
+        }
+
+        // Moves the buffered records out, oldest first, and empties the ring.
+        std::vector<BacktraceRecord> drain() {
+            std::vector<BacktraceRecord> records;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            records.reserve(m_size);
+            size_t start = (m_next + m_records.size() - m_size) % std::max<size_t>(1, m_records.size());
+            for (size_t i = 0; i < m_size; ++i) {
+                records.push_back(std::move(m_records[(start + i) % m_records.size()]));
+            }
+            m_size = 0;
+            return records;
+        }
+
+    private:
+        std::atomic<size_t> m_capacity;
+        std::mutex m_mutex;
+        std::vector<BacktraceRecord> m_records;
+        size_t m_next;
+        size_t m_size;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_BACKTRACE_BUFFER_HPP
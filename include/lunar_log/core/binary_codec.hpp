@@ -0,0 +1,123 @@
+#ifndef LUNAR_LOG_BINARY_CODEC_HPP
+#define LUNAR_LOG_BINARY_CODEC_HPP
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+
+namespace minta {
+    inline void appendVarint(std::string &out, uint64_t value) {
+        while (value >= 0x80) {
+            out += static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        out += static_cast<char>(value);
+    }
+
+    inline void appendZigZag(std::string &out, int64_t value) {
+        appendVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    inline void appendLengthPrefixed(std::string &out, const std::string &value) {
+        appendVarint(out, value.size());
+        out += value;
+    }
+
+    inline int64_t toEpochNanos(const std::chrono::system_clock::time_point &time) {
+        return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+    }
+
+    inline std::chrono::system_clock::time_point fromEpochNanos(int64_t nanos) {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos)));
+    }
+
+    // Bounds-checked reader over an encoded buffer. Every read returns false
+    // instead of running past the end, leaving the cursor where it was.
+    class BinaryCursor {
+    public:
+        BinaryCursor(const char *data, size_t size)
+            : m_data(data), m_size(size), m_pos(0) {
+        }
+
+        bool atEnd() const {
+            return m_pos >= m_size;
+        }
+
+        size_t offset() const {
+            return m_pos;
+        }
+
+        size_t remaining() const {
+            return m_size - m_pos;
+        }
+
+        void seek(size_t offset) {
+            m_pos = offset < m_size ? offset : m_size;
+        }
+
+        bool readByte(uint8_t &value) {
+            if (m_pos >= m_size) {
+                return false;
+            }
+            value = static_cast<uint8_t>(m_data[m_pos++]);
+            return true;
+        }
+
+        bool readBytes(void *target, size_t count) {
+            if (remaining() < count) {
+                return false;
+            }
+            std::memcpy(target, m_data + m_pos, count);
+            m_pos += count;
+            return true;
+        }
+
+        bool readVarint(uint64_t &value) {
+            uint64_t result = 0;
+            size_t pos = m_pos;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (pos >= m_size) {
+                    return false;
+                }
+                uint8_t byte = static_cast<uint8_t>(m_data[pos++]);
+                result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) {
+                    value = result;
+                    m_pos = pos;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool readZigZag(int64_t &value) {
+            uint64_t raw;
+            if (!readVarint(raw)) {
+                return false;
+            }
+            value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+            return true;
+        }
+
+        bool readLengthPrefixed(std::string &value) {
+            size_t start = m_pos;
+            uint64_t length;
+            if (!readVarint(length) || remaining() < length) {
+                m_pos = start;
+                return false;
+            }
+            value.assign(m_data + m_pos, static_cast<size_t>(length));
+            m_pos += static_cast<size_t>(length);
+            return true;
+        }
+
+    private:
+        const char *m_data;
+        size_t m_size;
+        size_t m_pos;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_BINARY_CODEC_HPP
@@ -0,0 +1,92 @@
+#ifndef LUNAR_LOG_CRC32C_HPP
+#define LUNAR_LOG_CRC32C_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LUNAR_LOG_CRC32C_X86 1
+#include <nmmintrin.h>
+#endif
+
+namespace minta {
+    namespace detail {
+        struct Crc32cTable {
+            uint32_t values[256];
+
+            Crc32cTable() {
+                for (uint32_t i = 0; i < 256; ++i) {
+                    uint32_t crc = i;
+                    for (int bit = 0; bit < 8; ++bit) {
+                        crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+                    }
+                    values[i] = crc;
+                }
+            }
+        };
+
+        inline const uint32_t *crc32cTable() {
+            static const Crc32cTable table;
+            return table.values;
+        }
+
+        inline uint32_t crc32cSoftware(uint32_t crc, const unsigned char *data, size_t size) {
+            const uint32_t *table = crc32cTable();
+            for (size_t i = 0; i < size; ++i) {
+                crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+            }
+            return crc;
+        }
+
+#ifdef LUNAR_LOG_CRC32C_X86
+        __attribute__((target("sse4.2")))
+        inline uint32_t crc32cHardware(uint32_t crc, const unsigned char *data, size_t size) {
+#if defined(__x86_64__)
+            uint64_t crc64 = crc;
+            while (size >= 8) {
+                uint64_t word;
+                std::memcpy(&word, data, sizeof(word));
+                crc64 = _mm_crc32_u64(crc64, word);
+                data += 8;
+                size -= 8;
+            }
+            crc = static_cast<uint32_t>(crc64);
+#endif
+            while (size >= 4) {
+                uint32_t word;
+                std::memcpy(&word, data, sizeof(word));
+                crc = _mm_crc32_u32(crc, word);
+                data += 4;
+                size -= 4;
+            }
+            while (size > 0) {
+                crc = _mm_crc32_u8(crc, *data++);
+                --size;
+            }
+            return crc;
+        }
+
+        inline bool crc32cHardwareAvailable() {
+            static const bool available = __builtin_cpu_supports("sse4.2");
+            return available;
+        }
+#endif
+    } // namespace detail
+
+    // CRC-32C (Castagnoli). Uses the SSE4.2 crc32 instruction when the CPU has it
+    // and a table-driven implementation otherwise. Pass the previous result as
+    // crc to checksum data in several pieces.
+    inline uint32_t crc32c(const void *data, size_t size, uint32_t crc = 0) {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        crc = ~crc;
+#ifdef LUNAR_LOG_CRC32C_X86
+        if (detail::crc32cHardwareAvailable()) {
+            return ~detail::crc32cHardware(crc, bytes, size);
+        }
+#endif
+        return ~detail::crc32cSoftware(crc, bytes, size);
+    }
+} // namespace minta
+
+#endif // LUNAR_LOG_CRC32C_HPP
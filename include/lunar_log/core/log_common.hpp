@@ -7,6 +7,7 @@
 #include <iomanip>
 #include <vector>
 #include <memory>
+#include <ctime>
 
 namespace minta {
 #if __cplusplus < 201402L
@@ -18,6 +19,52 @@ namespace minta {
     using std::make_unique;
 #endif
 
+    inline std::string renderMessageTemplate(const std::string &messageTemplate, const std::vector<std::string> &values) {
+        std::string result;
+        result.reserve(messageTemplate.length());
+        size_t valueIndex = 0;
+
+        for (size_t i = 0; i < messageTemplate.length(); ++i) {
+            if (messageTemplate[i] == '{') {
+                if (i + 1 < messageTemplate.length() && messageTemplate[i + 1] == '{') {
+                    result += '{';
+                    ++i;
+                } else {
+                    size_t endPos = messageTemplate.find("}", i);
+                    if (endPos == std::string::npos) {
+                        result += messageTemplate[i];
+                    } else if (valueIndex < values.size()) {
+                        result += values[valueIndex++];
+                        i = endPos;
+                    } else {
+                        result += messageTemplate.substr(i, endPos - i + 1);
+                        i = endPos;
+                    }
+                }
+            } else if (messageTemplate[i] == '}') {
+                if (i + 1 < messageTemplate.length() && messageTemplate[i + 1] == '}') {
+                    result += '}';
+                    ++i;
+                } else {
+                    result += messageTemplate[i];
+                }
+            } else {
+                result += messageTemplate[i];
+            }
+        }
+        return result;
+    }
+
+    inline std::tm toLocalTime(std::time_t time) {
+        std::tm result;
+#if defined(_WIN32)
+        localtime_s(&result, &time);
+#else
+        localtime_r(&time, &result);
+#endif
+        return result;
+    }
+
     inline std::string formatTimestamp(const std::chrono::system_clock::time_point &time) {
         auto nowTime = std::chrono::system_clock::to_time_t(time);
         auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()) % 1000;
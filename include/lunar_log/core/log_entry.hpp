@@ -6,6 +6,7 @@
 #include <chrono>
 #include <vector>
 #include <map>
+#include <thread>
 
 namespace minta {
     struct LogEntry {
@@ -18,6 +19,9 @@ namespace minta {
         int line;
         std::string function;
         std::map<std::string, std::string> customContext;
+        std::thread::id threadId;
+        // Routing category from LunarLog::logTagged; empty for untagged entries.
+        std::string tag;
     };
 } // namespace minta
 
@@ -0,0 +1,337 @@
+#ifndef LUNAR_LOG_FILTER_HPP
+#define LUNAR_LOG_FILTER_HPP
+
+#include "log_entry.hpp"
+#include <cctype>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+namespace minta {
+    namespace detail {
+        // '*' matches any run of characters and '?' any single character.
+        inline bool globMatch(const char *pattern, const char *patternEnd, const char *text, const char *textEnd) {
+            const char *starPattern = nullptr;
+            const char *starText = nullptr;
+            while (text != textEnd) {
+                if (pattern != patternEnd && (*pattern == '?' || *pattern == *text)) {
+                    ++pattern;
+                    ++text;
+                } else if (pattern != patternEnd && *pattern == '*') {
+                    starPattern = ++pattern;
+                    starText = text;
+                } else if (starPattern) {
+                    pattern = starPattern;
+                    text = ++starText;
+                } else {
+                    return false;
+                }
+            }
+            while (pattern != patternEnd && *pattern == '*') {
+                ++pattern;
+            }
+            return pattern == patternEnd;
+        }
+
+        inline bool globMatch(const std::string &pattern, const std::string &text) {
+            return globMatch(pattern.data(), pattern.data() + pattern.size(), text.data(), text.data() + text.size());
+        }
+
+        class FilterParser {
+        public:
+            typedef std::function<bool(const LogEntry &)> Predicate;
+
+            explicit FilterParser(const std::string &expression)
+                : m_expression(expression), m_pos(0) {
+            }
+
+            Predicate parse() {
+                Predicate predicate = parseOr();
+                skipSpace();
+                if (m_pos != m_expression.size()) {
+                    fail("unexpected input");
+                }
+                return predicate;
+            }
+
+        private:
+            enum class Field { Level, Message, Template, File, Function, Tag, Context, Argument };
+            enum class Op { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, Match, NotMatch, Exists };
+
+            const std::string &m_expression;
+            size_t m_pos;
+
+            Predicate parseOr() {
+                Predicate left = parseAnd();
+                while (accept("||")) {
+                    Predicate right = parseAnd();
+                    left = [left, right](const LogEntry &entry) { return left(entry) || right(entry); };
+                }
+                return left;
+            }
+
+            Predicate parseAnd() {
+                Predicate left = parseUnary();
+                while (accept("&&")) {
+                    Predicate right = parseUnary();
+                    left = [left, right](const LogEntry &entry) { return left(entry) && right(entry); };
+                }
+                return left;
+            }
+
+            Predicate parseUnary() {
+                skipSpace();
+                if (peek("!") && !peek("!=") && !peek("!~")) {
+                    ++m_pos;
+                    Predicate operand = parseUnary();
+                    return [operand](const LogEntry &entry) { return !operand(entry); };
+                }
+                if (accept("(")) {
+                    Predicate inner = parseOr();
+                    if (!accept(")")) {
+                        fail("expected ')'");
+                    }
+                    return inner;
+                }
+                return parseComparison();
+            }
+
+            Predicate parseComparison() {
+                size_t fieldPos = m_pos;
+                std::string name = readWord();
+                if (name.empty()) {
+                    fail("expected a field");
+                }
+                if (name == "true" || name == "false") {
+                    bool value = name == "true";
+                    return [value](const LogEntry &) { return value; };
+                }
+
+                Field field;
+                std::string key;
+                if (name == "level") field = Field::Level;
+                else if (name == "message") field = Field::Message;
+                else if (name == "template") field = Field::Template;
+                else if (name == "file") field = Field::File;
+                else if (name == "function") field = Field::Function;
+                else if (name == "tag") field = Field::Tag;
+                else if (name.compare(0, 4, "ctx.") == 0 && name.size() > 4) {
+                    field = Field::Context;
+                    key = name.substr(4);
+                } else if (name.compare(0, 4, "arg.") == 0 && name.size() > 4) {
+                    field = Field::Argument;
+                    key = name.substr(4);
+                } else {
+                    m_pos = fieldPos;
+                    fail("unknown field '" + name + "'");
+                }
+
+                Op op = readOp();
+                if (op == Op::Exists) {
+                    if (field != Field::Context && field != Field::Argument) {
+                        fail("expected an operator");
+                    }
+                    return makeTextPredicate(field, key, op, std::string());
+                }
+
+                skipSpace();
+                size_t valuePos = m_pos;
+                std::string value = readValue();
+                if (field == Field::Level) {
+                    LogLevel level;
+                    if (!parseLevel(value, level)) {
+                        m_pos = valuePos;
+                        fail("unknown level '" + value + "'");
+                    }
+                    if (op == Op::Match || op == Op::NotMatch) {
+                        fail("'~' cannot be used with level");
+                    }
+                    return makeLevelPredicate(op, level);
+                }
+                if (op != Op::Equal && op != Op::NotEqual && op != Op::Match && op != Op::NotMatch) {
+                    fail("ordering operators only apply to level");
+                }
+                return makeTextPredicate(field, key, op, value);
+            }
+
+            static Predicate makeLevelPredicate(Op op, LogLevel level) {
+                switch (op) {
+                    case Op::Equal: return [level](const LogEntry &entry) { return entry.level == level; };
+                    case Op::NotEqual: return [level](const LogEntry &entry) { return entry.level != level; };
+                    case Op::Less: return [level](const LogEntry &entry) { return entry.level < level; };
+                    case Op::LessEqual: return [level](const LogEntry &entry) { return entry.level <= level; };
+                    case Op::Greater: return [level](const LogEntry &entry) { return entry.level > level; };
+                    default: return [level](const LogEntry &entry) { return entry.level >= level; };
+                }
+            }
+
+            // Returns the field's value, or null when a context key or argument is absent.
+            static const std::string *lookup(const LogEntry &entry, Field field, const std::string &key) {
+                switch (field) {
+                    case Field::Message: return &entry.message;
+                    case Field::Template: return &entry.templateStr;
+                    case Field::File: return &entry.file;
+                    case Field::Function: return &entry.function;
+                    case Field::Tag: return &entry.tag;
+                    case Field::Context: {
+                        auto it = entry.customContext.find(key);
+                        return it == entry.customContext.end() ? nullptr : &it->second;
+                    }
+                    default:
+                        for (const auto &argument : entry.arguments) {
+                            if (argument.first == key) {
+                                return &argument.second;
+                            }
+                        }
+                        return nullptr;
+                }
+            }
+
+            static Predicate makeTextPredicate(Field field, const std::string &key, Op op, const std::string &value) {
+                switch (op) {
+                    case Op::Exists:
+                        return [field, key](const LogEntry &entry) { return lookup(entry, field, key) != nullptr; };
+                    case Op::Equal:
+                        return [field, key, value](const LogEntry &entry) {
+                            const std::string *text = lookup(entry, field, key);
+                            return text && *text == value;
+                        };
+                    case Op::NotEqual:
+                        return [field, key, value](const LogEntry &entry) {
+                            const std::string *text = lookup(entry, field, key);
+                            return !text || *text != value;
+                        };
+                    case Op::Match:
+                        return [field, key, value](const LogEntry &entry) {
+                            const std::string *text = lookup(entry, field, key);
+                            return text && globMatch(value, *text);
+                        };
+                    default:
+                        return [field, key, value](const LogEntry &entry) {
+                            const std::string *text = lookup(entry, field, key);
+                            return !text || !globMatch(value, *text);
+                        };
+                }
+            }
+
+            static bool parseLevel(const std::string &name, LogLevel &level) {
+                static const LogLevel levels[] = {LogLevel::TRACE, LogLevel::DEBUG, LogLevel::INFO,
+                                                  LogLevel::WARN, LogLevel::ERROR, LogLevel::FATAL};
+                for (LogLevel candidate : levels) {
+                    const char *levelName = getLevelString(candidate);
+                    if (std::strlen(levelName) != name.size()) continue;
+                    bool equal = true;
+                    for (size_t i = 0; i < name.size() && equal; ++i) {
+                        equal = std::toupper(static_cast<unsigned char>(name[i])) == levelName[i];
+                    }
+                    if (equal) {
+                        level = candidate;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            Op readOp() {
+                skipSpace();
+                if (accept("==")) return Op::Equal;
+                if (accept("!=")) return Op::NotEqual;
+                if (accept("!~")) return Op::NotMatch;
+                if (accept("<=")) return Op::LessEqual;
+                if (accept(">=")) return Op::GreaterEqual;
+                if (accept("<")) return Op::Less;
+                if (accept(">")) return Op::Greater;
+                if (accept("~")) return Op::Match;
+                return Op::Exists;
+            }
+
+            // A quoted string with \" and \\ escapes, or a bare word such as WARN or 42.
+            std::string readValue() {
+                if (m_pos < m_expression.size() && m_expression[m_pos] == '"') {
+                    std::string value;
+                    ++m_pos;
+                    while (m_pos < m_expression.size() && m_expression[m_pos] != '"') {
+                        if (m_expression[m_pos] == '\\' && m_pos + 1 < m_expression.size()) {
+                            ++m_pos;
+                        }
+                        value += m_expression[m_pos++];
+                    }
+                    if (m_pos == m_expression.size()) {
+                        fail("unterminated string");
+                    }
+                    ++m_pos;
+                    return value;
+                }
+                std::string value = readWord();
+                if (value.empty()) {
+                    fail("expected a value");
+                }
+                return value;
+            }
+
+            std::string readWord() {
+                skipSpace();
+                size_t start = m_pos;
+                while (m_pos < m_expression.size()) {
+                    char c = m_expression[m_pos];
+                    if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '.' && c != '-') break;
+                    ++m_pos;
+                }
+                return m_expression.substr(start, m_pos - start);
+            }
+
+            void skipSpace() {
+                while (m_pos < m_expression.size() && std::isspace(static_cast<unsigned char>(m_expression[m_pos]))) {
+                    ++m_pos;
+                }
+            }
+
+            bool peek(const char *token) const {
+                return m_expression.compare(m_pos, std::strlen(token), token) == 0;
+            }
+
+            bool accept(const char *token) {
+                skipSpace();
+                if (!peek(token)) return false;
+                m_pos += std::strlen(token);
+                return true;
+            }
+
+            void fail(const std::string &message) const {
+                throw std::invalid_argument("LogFilter: " + message + " at position " + std::to_string(m_pos) +
+                                            " in \"" + m_expression + "\"");
+            }
+        };
+    } // namespace detail
+
+    // A filter expression compiled once into a tree of closures:
+    //
+    //   level >= WARN || ctx.tenant == "acme" || template ~ "payment*"
+    //
+    // Fields are level, message, template, file, function, tag, ctx.<key> and
+    // arg.<name>. Text fields take ==, != and the glob operators ~ and !~; level
+    // also takes < <= > >=. A bare ctx.<key> or arg.<name> tests for presence.
+    // Combine with !, &&, || and parentheses. Invalid expressions throw
+    // std::invalid_argument from the constructor.
+    class LogFilter {
+    public:
+        explicit LogFilter(const std::string &expression) : m_expression(expression) {
+            m_predicate = detail::FilterParser(expression).parse();
+        }
+
+        bool matches(const LogEntry &entry) const {
+            return m_predicate(entry);
+        }
+
+        const std::string &expression() const {
+            return m_expression;
+        }
+
+    private:
+        std::string m_expression;
+        detail::FilterParser::Predicate m_predicate;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_FILTER_HPP
@@ -22,6 +22,18 @@ namespace minta {
             default: return "UNKNOWN";
         }
     }
+
+    inline char getLevelAbbreviation(LogLevel level) {
+        switch (level) {
+            case LogLevel::TRACE: return 'T';
+            case LogLevel::DEBUG: return 'D';
+            case LogLevel::INFO: return 'I';
+            case LogLevel::WARN: return 'W';
+            case LogLevel::ERROR: return 'E';
+            case LogLevel::FATAL: return 'F';
+            default: return '?';
+        }
+    }
 } // namespace minta
 
 #endif // LUNAR_LOG_LEVEL_HPP
@@ -0,0 +1,90 @@
+#ifndef LUNAR_LOG_STATS_HPP
+#define LUNAR_LOG_STATS_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace minta {
+    // Identifies a sink added to a logger; ids are never reused.
+    typedef uint64_t SinkId;
+
+    struct SinkStats {
+        SinkId id;
+        uint64_t entries;
+        // Formatted bytes handed to the sink; 0 for sinks that format themselves.
+        uint64_t bytes;
+        uint64_t writeNanos;
+        // Writes that threw; the entry is lost for this sink only.
+        uint64_t errors;
+        // Bucket i counts writes that took [2^i, 2^(i+1)) nanoseconds.
+        std::vector<uint64_t> writeLatency;
+    };
+
+    struct LogStats {
+        uint64_t enqueued;
+        uint64_t droppedRateLimited;
+        uint64_t droppedOverflow;
+        size_t queueDepth;
+        size_t queueHighWater;
+        uint64_t workerBusyNanos;
+        std::vector<SinkStats> sinks;
+    };
+
+    // Relaxed atomic counters for one sink, updated by the worker thread and
+    // read at any time by getStats().
+    class SinkCounters {
+    public:
+        enum { LatencyBuckets = 40 };
+
+        SinkCounters() : m_entries(0), m_bytes(0), m_writeNanos(0), m_errors(0) {
+            for (auto &bucket : m_latency) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        void record(uint64_t bytes, uint64_t nanos) {
+            m_entries.fetch_add(1, std::memory_order_relaxed);
+            m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+            m_writeNanos.fetch_add(nanos, std::memory_order_relaxed);
+            m_latency[bucketFor(nanos)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void recordError() {
+            m_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        SinkStats snapshot() const {
+            SinkStats stats;
+            stats.id = 0;
+            stats.entries = m_entries.load(std::memory_order_relaxed);
+            stats.bytes = m_bytes.load(std::memory_order_relaxed);
+            stats.writeNanos = m_writeNanos.load(std::memory_order_relaxed);
+            stats.errors = m_errors.load(std::memory_order_relaxed);
+            stats.writeLatency.reserve(LatencyBuckets);
+            for (const auto &bucket : m_latency) {
+                stats.writeLatency.push_back(bucket.load(std::memory_order_relaxed));
+            }
+            return stats;
+        }
+
+        static size_t bucketFor(uint64_t nanos) {
+            size_t bucket = 0;
+            while (nanos > 1 && bucket + 1 < LatencyBuckets) {
+                nanos >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+    private:
+        std::atomic<uint64_t> m_entries;
+        std::atomic<uint64_t> m_bytes;
+        std::atomic<uint64_t> m_writeNanos;
+        std::atomic<uint64_t> m_errors;
+        std::array<std::atomic<uint64_t>, LatencyBuckets> m_latency;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_STATS_HPP
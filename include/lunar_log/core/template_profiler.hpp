@@ -0,0 +1,147 @@
+#ifndef LUNAR_LOG_TEMPLATE_PROFILER_HPP
+#define LUNAR_LOG_TEMPLATE_PROFILER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace minta {
+    struct TemplateProfile {
+        std::string templateStr;
+        uint64_t calls;
+        uint64_t bytes;
+        uint64_t callerNanos;
+        uint64_t workerNanos;
+
+        uint64_t totalNanos() const {
+            return callerNanos + workerNanos;
+        }
+    };
+
+    enum class ProfileOrder {
+        TotalTime,
+        CallerTime,
+        WorkerTime,
+        Calls,
+        Bytes
+    };
+
+    // Per-template cost counters. Each thread records into the shard picked by
+    // its thread id, so producers rarely share a lock; report() merges shards.
+    class TemplateProfiler {
+    public:
+        void recordCall(const std::string &templateStr, uint64_t callerNanos) {
+            Shard &shard = shardForThisThread();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            Counters &counters = shard.counters[templateStr];
+            ++counters.calls;
+            counters.callerNanos += callerNanos;
+        }
+
+        void recordWrite(const std::string &templateStr, uint64_t bytes, uint64_t workerNanos) {
+            Shard &shard = shardForThisThread();
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            Counters &counters = shard.counters[templateStr];
+            counters.bytes += bytes;
+            counters.workerNanos += workerNanos;
+        }
+
+        std::vector<TemplateProfile> report(ProfileOrder order = ProfileOrder::TotalTime) const {
+            std::unordered_map<std::string, Counters> merged;
+            for (const Shard &shard : m_shards) {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                for (const auto &item : shard.counters) {
+                    Counters &counters = merged[item.first];
+                    counters.calls += item.second.calls;
+                    counters.bytes += item.second.bytes;
+                    counters.callerNanos += item.second.callerNanos;
+                    counters.workerNanos += item.second.workerNanos;
+                }
+            }
+
+            std::vector<TemplateProfile> profiles;
+            profiles.reserve(merged.size());
+            for (const auto &item : merged) {
+                profiles.push_back(TemplateProfile{item.first, item.second.calls, item.second.bytes,
+                                                   item.second.callerNanos, item.second.workerNanos});
+            }
+            std::sort(profiles.begin(), profiles.end(), [order](const TemplateProfile &a, const TemplateProfile &b) {
+                uint64_t left = sortKey(a, order);
+                uint64_t right = sortKey(b, order);
+                return left != right ? left > right : a.templateStr < b.templateStr;
+            });
+            return profiles;
+        }
+
+        void reset() {
+            for (Shard &shard : m_shards) {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.counters.clear();
+            }
+        }
+
+        // Plain-text table of the first `limit` profiles.
+        static std::string formatReport(const std::vector<TemplateProfile> &profiles, size_t limit = 20) {
+            std::ostringstream out;
+            out << std::right << std::setw(10) << "calls" << std::setw(12) << "bytes"
+                << std::setw(12) << "caller ms" << std::setw(12) << "worker ms"
+                << std::setw(10) << "ns/call" << "  template\n";
+            out << std::fixed << std::setprecision(2);
+            for (size_t i = 0; i < profiles.size() && i < limit; ++i) {
+                const TemplateProfile &profile = profiles[i];
+                out << std::setw(10) << profile.calls << std::setw(12) << profile.bytes
+                    << std::setw(12) << static_cast<double>(profile.callerNanos) / 1e6
+                    << std::setw(12) << static_cast<double>(profile.workerNanos) / 1e6
+                    << std::setw(10) << std::setprecision(0)
+                    << (profile.calls ? static_cast<double>(profile.totalNanos()) / static_cast<double>(profile.calls) : 0.0)
+                    << std::setprecision(2) << "  " << profile.templateStr << "\n";
+            }
+            return out.str();
+        }
+
+    private:
+        enum { ShardCount = 16 };
+
+        struct Counters {
+            Counters() : calls(0), bytes(0), callerNanos(0), workerNanos(0) {
+            }
+
+            uint64_t calls;
+            uint64_t bytes;
+            uint64_t callerNanos;
+            uint64_t workerNanos;
+        };
+
+        struct Shard {
+            mutable std::mutex mutex;
+            std::unordered_map<std::string, Counters> counters;
+        };
+
+        std::array<Shard, ShardCount> m_shards;
+
+        Shard &shardForThisThread() {
+            return m_shards[std::hash<std::thread::id>()(std::this_thread::get_id()) % ShardCount];
+        }
+
+        static uint64_t sortKey(const TemplateProfile &profile, ProfileOrder order) {
+            switch (order) {
+                case ProfileOrder::CallerTime: return profile.callerNanos;
+                case ProfileOrder::WorkerTime: return profile.workerNanos;
+                case ProfileOrder::Calls: return profile.calls;
+                case ProfileOrder::Bytes: return profile.bytes;
+                case ProfileOrder::TotalTime:
+                default: return profile.totalNanos();
+            }
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_TEMPLATE_PROFILER_HPP
@@ -0,0 +1,213 @@
+#ifndef LUNAR_LOG_BINARY_FORMATTER_HPP
+#define LUNAR_LOG_BINARY_FORMATTER_HPP
+
+#include "formatter_interface.hpp"
+#include "../core/binary_codec.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+namespace minta {
+    // Layout shared by BinaryFormatter and BinaryLogReader.
+    //
+    // A stream is a sequence of segments, each starting with the magic bytes.
+    // Templates and dictionary strings are scoped to their segment, so a reader
+    // can start decoding at any magic. Every formatter instance starts a new
+    // segment before its first record, so files appended to by several processes
+    // decode cleanly. Each record starts with a tag:
+    //   template: id, template string, placeholder names
+    //   string:   id, string (ids start at 1)
+    //   entry:    template id, level, zigzag timestamp delta (ns), flags,
+    //             argument values, [file, line, function], [context pairs]
+    // Strings are length-prefixed and integers are varints. With FlagDictionary,
+    // every string in the entry is instead a string id, or 0 followed by the
+    // length-prefixed string for values kept out of the dictionary.
+    struct BinaryLogFormat {
+        enum : uint8_t {
+            RecordTemplate = 0x01,
+            RecordEntry = 0x02,
+            RecordString = 0x03
+        };
+
+        enum : uint8_t {
+            FlagSource = 0x01,
+            FlagContext = 0x02,
+            FlagDictionary = 0x04
+        };
+
+        static const char *magic() {
+            return "LLBIN\x01";
+        }
+
+        static size_t magicSize() {
+            return 6;
+        }
+    };
+
+    struct BinaryDictionaryOptions {
+        BinaryDictionaryOptions(size_t maxEntries = 4096, size_t maxValueLength = 256, size_t segmentEntries = 0)
+            : maxEntries(maxEntries), maxValueLength(maxValueLength), segmentEntries(segmentEntries) {
+        }
+
+        // Dictionary size at which a new segment is started.
+        size_t maxEntries;
+        // Longer strings are written inline rather than added to the dictionary.
+        size_t maxValueLength;
+        // Start a new segment after this many entries; 0 resets only when full.
+        size_t segmentEntries;
+    };
+
+    // Encodes entries as template ids plus raw argument values. Each template is
+    // written once per segment, the first time it is seen with a given number of
+    // arguments. The rendered message is not stored; readers re-render it.
+    //
+    // When constructed with BinaryDictionaryOptions, argument values, source
+    // location and context are also dictionary-encoded: a string is written once
+    // per segment and referenced by id afterwards.
+    class BinaryFormatter : public IFormatter {
+    public:
+        BinaryFormatter()
+            : m_useDictionary(false), m_sessionStarted(false), m_nextTemplateId(0), m_nextStringId(1),
+              m_lastTimestamp(0), m_segmentEntries(0) {
+        }
+
+        explicit BinaryFormatter(const BinaryDictionaryOptions &options)
+            : m_useDictionary(true), m_options(options), m_sessionStarted(false), m_nextTemplateId(0),
+              m_nextStringId(1), m_lastTimestamp(0), m_segmentEntries(0) {
+        }
+
+        std::string format(const LogEntry &entry) const override {
+            std::string out;
+            formatTo(entry, out);
+            return out;
+        }
+
+        void formatTo(const LogEntry &entry, std::string &out) const override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_sessionStarted || segmentFull(entry)) {
+                startSegment(out);
+            }
+            ++m_segmentEntries;
+
+            uint64_t templateId = lookupTemplate(entry, out);
+            int64_t timestamp = toEpochNanos(entry.timestamp);
+
+            uint8_t flags = 0;
+            if (!entry.file.empty()) flags |= BinaryLogFormat::FlagSource;
+            if (!entry.customContext.empty()) flags |= BinaryLogFormat::FlagContext;
+            if (m_useDictionary) flags |= BinaryLogFormat::FlagDictionary;
+
+            // String definitions must precede the entry that uses them, so the
+            // entry body is built separately and appended last.
+            std::string &body = m_body;
+            body.clear();
+            body += static_cast<char>(BinaryLogFormat::RecordEntry);
+            appendVarint(body, templateId);
+            body += static_cast<char>(entry.level);
+            appendZigZag(body, timestamp - m_lastTimestamp);
+            body += static_cast<char>(flags);
+            m_lastTimestamp = timestamp;
+
+            for (const auto &argument : entry.arguments) {
+                appendString(body, argument.second, out);
+            }
+
+            if (flags & BinaryLogFormat::FlagSource) {
+                appendString(body, entry.file, out);
+                appendVarint(body, static_cast<uint64_t>(entry.line));
+                appendString(body, entry.function, out);
+            }
+
+            if (flags & BinaryLogFormat::FlagContext) {
+                appendVarint(body, entry.customContext.size());
+                for (const auto &ctx : entry.customContext) {
+                    appendString(body, ctx.first, out);
+                    appendString(body, ctx.second, out);
+                }
+            }
+
+            out += body;
+        }
+
+    private:
+        bool m_useDictionary;
+        BinaryDictionaryOptions m_options;
+        mutable std::mutex m_mutex;
+        mutable bool m_sessionStarted;
+        mutable uint64_t m_nextTemplateId;
+        mutable uint64_t m_nextStringId;
+        mutable int64_t m_lastTimestamp;
+        mutable size_t m_segmentEntries;
+        mutable std::string m_body;
+        // template string -> (argument count, template id)
+        mutable std::unordered_map<std::string, std::vector<std::pair<size_t, uint64_t> > > m_templates;
+        mutable std::unordered_map<std::string, uint64_t> m_strings;
+
+        bool segmentFull(const LogEntry &entry) const {
+            if (!m_useDictionary) {
+                return false;
+            }
+            if (m_options.segmentEntries > 0 && m_segmentEntries >= m_options.segmentEntries) {
+                return true;
+            }
+            size_t newStrings = entry.arguments.size() + 2 + entry.customContext.size() * 2;
+            return m_strings.size() + newStrings > m_options.maxEntries;
+        }
+
+        void startSegment(std::string &out) const {
+            out.append(BinaryLogFormat::magic(), BinaryLogFormat::magicSize());
+            m_sessionStarted = true;
+            m_templates.clear();
+            m_strings.clear();
+            m_nextTemplateId = 0;
+            m_nextStringId = 1;
+            m_lastTimestamp = 0;
+            m_segmentEntries = 0;
+        }
+
+        void appendString(std::string &body, const std::string &value, std::string &out) const {
+            if (!m_useDictionary) {
+                appendLengthPrefixed(body, value);
+                return;
+            }
+            if (value.size() > m_options.maxValueLength) {
+                appendVarint(body, 0);
+                appendLengthPrefixed(body, value);
+                return;
+            }
+
+            auto it = m_strings.find(value);
+            if (it == m_strings.end()) {
+                it = m_strings.emplace(value, m_nextStringId++).first;
+                out += static_cast<char>(BinaryLogFormat::RecordString);
+                appendVarint(out, it->second);
+                appendLengthPrefixed(out, value);
+            }
+            appendVarint(body, it->second);
+        }
+
+        uint64_t lookupTemplate(const LogEntry &entry, std::string &out) const {
+            auto &variants = m_templates[entry.templateStr];
+            for (const auto &variant : variants) {
+                if (variant.first == entry.arguments.size()) {
+                    return variant.second;
+                }
+            }
+
+            uint64_t id = m_nextTemplateId++;
+            variants.emplace_back(entry.arguments.size(), id);
+
+            out += static_cast<char>(BinaryLogFormat::RecordTemplate);
+            appendVarint(out, id);
+            appendLengthPrefixed(out, entry.templateStr);
+            appendVarint(out, entry.arguments.size());
+            for (const auto &argument : entry.arguments) {
+                appendLengthPrefixed(out, argument.first);
+            }
+            return id;
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_BINARY_FORMATTER_HPP
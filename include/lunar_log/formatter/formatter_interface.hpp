@@ -10,6 +10,20 @@ namespace minta {
         virtual ~IFormatter() = default;
 
         virtual std::string format(const LogEntry &entry) const = 0;
+
+        // Appends the formatted entry to out; formatters that can write into an
+        // existing buffer override this to skip the intermediate string.
+        virtual void formatTo(const LogEntry &entry, std::string &out) const {
+            out += format(entry);
+        }
+
+        // True when the output depends only on the entry. Only such formatters
+        // may be shared between sinks, which then format each entry once;
+        // a formatter that carries state from one entry to the next (such as
+        // BinaryFormatter's dictionaries) must belong to a single sink.
+        virtual bool isStateless() const {
+            return false;
+        }
     };
 } // namespace minta
 
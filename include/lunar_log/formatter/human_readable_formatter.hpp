@@ -8,6 +8,10 @@
 namespace minta {
     class HumanReadableFormatter : public IFormatter {
     public:
+        bool isStateless() const override {
+            return true;
+        }
+
         std::string format(const LogEntry &entry) const override {
             std::ostringstream oss;
             oss << formatTimestamp(entry.timestamp) << " "
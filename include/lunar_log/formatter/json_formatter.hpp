@@ -3,62 +3,79 @@
 
 #include "formatter_interface.hpp"
 #include "../core/log_common.hpp"
-#include <sstream>
-#include <iomanip>
+#include <string>
 
 namespace minta {
     class JsonFormatter : public IFormatter {
     public:
+        bool isStateless() const override {
+            return true;
+        }
+
         std::string format(const LogEntry &entry) const override {
-            std::ostringstream json;
-            json << R"({)";
+            std::string json;
+            formatTo(entry, json);
+            return json;
+        }
 
-            json << R"("level":")" << getLevelString(entry.level) << R"(",)";
-            json << R"("timestamp":")" << formatTimestamp(entry.timestamp) << R"(",)";
-            json << R"("message":")" << escapeJsonString(entry.message) << R"(")";
+        void formatTo(const LogEntry &entry, std::string &json) const override {
+            json += R"({"level":")";
+            json += getLevelString(entry.level);
+            json += R"(","timestamp":")";
+            json += formatTimestamp(entry.timestamp);
+            json += R"(","message":")";
+            appendEscapedJsonString(json, entry.message);
+            json += '"';
 
             if (!entry.file.empty()) {
-                json << R"(,"file":")" << escapeJsonString(entry.file) << R"(",)";
-                json << R"("line":)" << entry.line << R"(,)";
-                json << R"("function":")" << escapeJsonString(entry.function) << R"(")";
+                json += R"(,"file":")";
+                appendEscapedJsonString(json, entry.file);
+                json += R"(","line":)";
+                json += std::to_string(entry.line);
+                json += R"(,"function":")";
+                appendEscapedJsonString(json, entry.function);
+                json += '"';
             }
 
             if (!entry.customContext.empty()) {
-                json << R"(,"context":{)";
+                json += R"(,"context":{)";
                 for (const auto &ctx : entry.customContext) {
-                    json << R"(")" << escapeJsonString(ctx.first) << R"(":")" << escapeJsonString(ctx.second) << R"(",)";
+                    json += '"';
+                    appendEscapedJsonString(json, ctx.first);
+                    json += R"(":")";
+                    appendEscapedJsonString(json, ctx.second);
+                    json += R"(",)";
                 }
-                json.seekp(-1, std::ios_base::end);
-                json << "}";
+                json.back() = '}';
             }
 
-            json << R"(})";
-            return json.str();
+            json += '}';
         }
 
     private:
-        static std::string escapeJsonString(const std::string &input) {
-            std::ostringstream result;
+        static void appendEscapedJsonString(std::string &out, const std::string &input) {
+            static const char hexDigits[] = "0123456789abcdef";
             for (char c : input) {
                 switch (c) {
-                    case '"': result << R"(\")"; break;
-                    case '\\': result << R"(\\)"; break;
-                    case '\b': result << R"(\b)"; break;
-                    case '\f': result << R"(\f)"; break;
-                    case '\n': result << R"(\n)"; break;
-                    case '\r': result << R"(\r)"; break;
-                    case '\t': result << R"(\t)"; break;
+                    case '"': out += R"(\")"; break;
+                    case '\\': out += R"(\\)"; break;
+                    case '\b': out += R"(\b)"; break;
+                    case '\f': out += R"(\f)"; break;
+                    case '\n': out += R"(\n)"; break;
+                    case '\r': out += R"(\r)"; break;
+                    case '\t': out += R"(\t)"; break;
                     default:
                         if ('\x00' <= c && c <= '\x1f') {
-                            result << R"(\u)" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+                            out += R"(\u00)";
+                            out += hexDigits[(c >> 4) & 0x0f];
+                            out += hexDigits[c & 0x0f];
                         } else {
-                            result << c;
+                            out += c;
                         }
                 }
             }
-            return result.str();
         }
     };
 } // namespace minta
 
-#endif // LUNAR_LOG_JSON_FORMATTER_HPP
\ No newline at end of file
+#endif // LUNAR_LOG_JSON_FORMATTER_HPP
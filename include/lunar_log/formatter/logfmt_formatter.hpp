@@ -0,0 +1,162 @@
+#ifndef LUNAR_LOG_LOGFMT_FORMATTER_HPP
+#define LUNAR_LOG_LOGFMT_FORMATTER_HPP
+
+#include "formatter_interface.hpp"
+#include "../core/log_common.hpp"
+#include <string>
+#include <cstdint>
+#include <cstring>
+
+namespace minta {
+    // Writes entries as logfmt: ts=... level=... msg=... followed by the source
+    // location, the template properties and the custom context as key=value pairs.
+    class LogfmtFormatter : public IFormatter {
+    public:
+        bool isStateless() const override {
+            return true;
+        }
+
+        std::string format(const LogEntry &entry) const override {
+            std::string out;
+            formatTo(entry, out);
+            return out;
+        }
+
+        void formatTo(const LogEntry &entry, std::string &out) const override {
+            out += "ts=";
+            appendTimestamp(out, entry.timestamp);
+            out += " level=";
+            out += getLevelName(entry.level);
+            out += " msg=";
+            appendValue(out, entry.message);
+
+            if (!entry.file.empty()) {
+                out += " file=";
+                appendValue(out, entry.file);
+                out += " line=";
+                out += std::to_string(entry.line);
+                out += " func=";
+                appendValue(out, entry.function);
+            }
+
+            for (const auto &argument : entry.arguments) {
+                appendPair(out, argument.first, argument.second);
+            }
+            for (const auto &ctx : entry.customContext) {
+                appendPair(out, ctx.first, ctx.second);
+            }
+        }
+
+        static bool needsQuoting(const std::string &value) {
+            if (value.empty()) {
+                return true;
+            }
+
+            const char *data = value.data();
+            size_t size = value.size();
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8) {
+                uint64_t word;
+                std::memcpy(&word, data + i, sizeof(word));
+                if (wordNeedsQuoting(word)) {
+                    return true;
+                }
+            }
+            for (; i < size; ++i) {
+                if (byteNeedsQuoting(static_cast<unsigned char>(data[i]))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    private:
+        static const char *getLevelName(LogLevel level) {
+            switch (level) {
+                case LogLevel::TRACE: return "trace";
+                case LogLevel::DEBUG: return "debug";
+                case LogLevel::INFO: return "info";
+                case LogLevel::WARN: return "warn";
+                case LogLevel::ERROR: return "error";
+                case LogLevel::FATAL: return "fatal";
+                default: return "unknown";
+            }
+        }
+
+        static bool byteNeedsQuoting(unsigned char c) {
+            return c <= ' ' || c == '"' || c == '=' || c == '\\' || c == 0x7f;
+        }
+
+        // Checks eight bytes at once: a byte below 0x21 or equal to '"', '=',
+        // '\\' or DEL sets that byte's high bit in the result.
+        static bool wordNeedsQuoting(uint64_t word) {
+            const uint64_t ones = 0x0101010101010101ULL;
+            const uint64_t highs = 0x8080808080808080ULL;
+            uint64_t below = (word - ones * 0x21) & ~word;
+            uint64_t quote = word ^ (ones * '"');
+            uint64_t equals = word ^ (ones * '=');
+            uint64_t backslash = word ^ (ones * '\\');
+            uint64_t del = word ^ (ones * 0x7f);
+            uint64_t matches = below |
+                               ((quote - ones) & ~quote) |
+                               ((equals - ones) & ~equals) |
+                               ((backslash - ones) & ~backslash) |
+                               ((del - ones) & ~del);
+            return (matches & highs) != 0;
+        }
+
+        static void appendTimestamp(std::string &out, const std::chrono::system_clock::time_point &time) {
+            auto sinceEpoch = time.time_since_epoch();
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+            auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(sinceEpoch - seconds).count();
+            std::tm local = toLocalTime(static_cast<std::time_t>(seconds.count()));
+
+            char buffer[32];
+            size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &local);
+            out.append(buffer, length);
+            out += '.';
+            out += static_cast<char>('0' + millis / 100);
+            out += static_cast<char>('0' + millis / 10 % 10);
+            out += static_cast<char>('0' + millis % 10);
+        }
+
+        static void appendPair(std::string &out, const std::string &key, const std::string &value) {
+            out += ' ';
+            for (char c : key) {
+                out += byteNeedsQuoting(static_cast<unsigned char>(c)) ? '_' : c;
+            }
+            out += '=';
+            appendValue(out, value);
+        }
+
+        static void appendValue(std::string &out, const std::string &value) {
+            if (!needsQuoting(value)) {
+                out += value;
+                return;
+            }
+
+            static const char hexDigits[] = "0123456789abcdef";
+            out += '"';
+            for (char c : value) {
+                switch (c) {
+                    case '"': out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            out += "\\u00";
+                            out += hexDigits[(c >> 4) & 0x0f];
+                            out += hexDigits[c & 0x0f];
+                        } else {
+                            out += c;
+                        }
+                }
+            }
+            out += '"';
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_LOGFMT_FORMATTER_HPP
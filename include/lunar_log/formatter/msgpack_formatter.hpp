@@ -0,0 +1,147 @@
+#ifndef LUNAR_LOG_MSGPACK_FORMATTER_HPP
+#define LUNAR_LOG_MSGPACK_FORMATTER_HPP
+
+#include "formatter_interface.hpp"
+#include "../core/binary_codec.hpp"
+#include <string>
+#include <cstdint>
+
+namespace minta {
+    // Encodes each entry as one MessagePack map. The timestamp uses the standard
+    // timestamp extension (type -1); properties and context are nested maps of
+    // strings, since LogEntry carries argument values in rendered form.
+    // Pair with BinaryFileTransport so no line terminator is inserted.
+    class MsgPackFormatter : public IFormatter {
+    public:
+        bool isStateless() const override {
+            return true;
+        }
+
+        std::string format(const LogEntry &entry) const override {
+            std::string out;
+            formatTo(entry, out);
+            return out;
+        }
+
+        void formatTo(const LogEntry &entry, std::string &out) const override {
+            bool hasSource = !entry.file.empty();
+            bool hasProperties = !entry.arguments.empty();
+            bool hasContext = !entry.customContext.empty();
+
+            appendMapHeader(out, 4 + (hasSource ? 3 : 0) + (hasProperties ? 1 : 0) + (hasContext ? 1 : 0));
+
+            appendString(out, "level", 5);
+            appendString(out, getLevelString(entry.level));
+            appendString(out, "timestamp", 9);
+            appendTimestamp(out, toEpochNanos(entry.timestamp));
+            appendString(out, "template", 8);
+            appendString(out, entry.templateStr);
+            appendString(out, "message", 7);
+            appendString(out, entry.message);
+
+            if (hasSource) {
+                appendString(out, "file", 4);
+                appendString(out, entry.file);
+                appendString(out, "line", 4);
+                appendInt(out, entry.line);
+                appendString(out, "function", 8);
+                appendString(out, entry.function);
+            }
+
+            if (hasProperties) {
+                appendString(out, "properties", 10);
+                appendMapHeader(out, entry.arguments.size());
+                for (const auto &argument : entry.arguments) {
+                    appendString(out, argument.first);
+                    appendString(out, argument.second);
+                }
+            }
+
+            if (hasContext) {
+                appendString(out, "context", 7);
+                appendMapHeader(out, entry.customContext.size());
+                for (const auto &ctx : entry.customContext) {
+                    appendString(out, ctx.first);
+                    appendString(out, ctx.second);
+                }
+            }
+        }
+
+    private:
+        static void appendBigEndian(std::string &out, uint64_t value, int bytes) {
+            for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+                out += static_cast<char>((value >> shift) & 0xff);
+            }
+        }
+
+        static void appendMapHeader(std::string &out, size_t size) {
+            if (size < 16) {
+                out += static_cast<char>(0x80 | size);
+            } else if (size <= 0xffff) {
+                out += static_cast<char>(0xde);
+                appendBigEndian(out, size, 2);
+            } else {
+                out += static_cast<char>(0xdf);
+                appendBigEndian(out, size, 4);
+            }
+        }
+
+        static void appendString(std::string &out, const char *data, size_t size) {
+            if (size < 32) {
+                out += static_cast<char>(0xa0 | size);
+            } else if (size <= 0xff) {
+                out += static_cast<char>(0xd9);
+                appendBigEndian(out, size, 1);
+            } else if (size <= 0xffff) {
+                out += static_cast<char>(0xda);
+                appendBigEndian(out, size, 2);
+            } else {
+                out += static_cast<char>(0xdb);
+                appendBigEndian(out, size, 4);
+            }
+            out.append(data, size);
+        }
+
+        static void appendString(std::string &out, const std::string &value) {
+            appendString(out, value.data(), value.size());
+        }
+
+        static void appendString(std::string &out, const char *value) {
+            appendString(out, value, std::char_traits<char>::length(value));
+        }
+
+        static void appendInt(std::string &out, int64_t value) {
+            if (value >= 0 && value < 128) {
+                out += static_cast<char>(value);
+            } else if (value >= -32 && value < 0) {
+                out += static_cast<char>(0xe0 | (value + 32));
+            } else {
+                out += static_cast<char>(0xd3);
+                appendBigEndian(out, static_cast<uint64_t>(value), 8);
+            }
+        }
+
+        static void appendTimestamp(std::string &out, int64_t epochNanos) {
+            int64_t seconds = epochNanos / 1000000000;
+            int64_t nanos = epochNanos % 1000000000;
+            if (nanos < 0) {
+                nanos += 1000000000;
+                --seconds;
+            }
+
+            if (seconds >= 0 && (static_cast<uint64_t>(seconds) >> 34) == 0) {
+                out += static_cast<char>(0xd7);
+                out += static_cast<char>(-1);
+                appendBigEndian(out, (static_cast<uint64_t>(nanos) << 34) | static_cast<uint64_t>(seconds), 8);
+            } else {
+                out += static_cast<char>(0xc7);
+                out += static_cast<char>(12);
+                out += static_cast<char>(-1);
+                appendBigEndian(out, static_cast<uint64_t>(nanos), 4);
+                appendBigEndian(out, static_cast<uint64_t>(seconds), 8);
+            }
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_MSGPACK_FORMATTER_HPP
@@ -0,0 +1,297 @@
+#ifndef LUNAR_LOG_PATTERN_FORMATTER_HPP
+#define LUNAR_LOG_PATTERN_FORMATTER_HPP
+
+#include "formatter_interface.hpp"
+#include "../core/log_common.hpp"
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace minta {
+    // Formats entries according to a layout pattern. The pattern is compiled once
+    // into a list of field writers, so rendering never re-parses it.
+    //
+    //   %Y %m %d %H %M %S   date and time fields (local time)
+    //   %e %f %F            milliseconds, microseconds, nanoseconds
+    //   %l %L               level name, single-letter level
+    //   %t                  thread id
+    //   %s %# %!            source file, line, function (with context capture)
+    //   %v %T               rendered message, message template
+    //   %ctx                custom context as {key=value, ...}
+    //   %%                  literal '%'
+    //
+    // Any field may carry a width and precision, e.g. %-8l pads the level to eight
+    // columns on the right, %10v pads the message on the left and %.20v truncates it.
+    class PatternFormatter : public IFormatter {
+    public:
+        explicit PatternFormatter(const std::string &pattern)
+            : m_needsTime(false) {
+            compile(pattern);
+        }
+
+        bool isStateless() const override {
+            return true;
+        }
+
+        std::string format(const LogEntry &entry) const override {
+            std::string out;
+            formatTo(entry, out);
+            return out;
+        }
+
+        void formatTo(const LogEntry &entry, std::string &out) const override {
+            RenderState state;
+            state.entry = &entry;
+            if (m_needsTime) {
+                auto sinceEpoch = entry.timestamp.time_since_epoch();
+                auto seconds = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+                state.time = toLocalTime(static_cast<std::time_t>(seconds.count()));
+                state.subsecondNanos = static_cast<long>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch - seconds).count());
+            }
+
+            for (const auto &op : m_ops) {
+                if (!op.padded) {
+                    op.write(op, state, out);
+                    continue;
+                }
+
+                size_t start = out.size();
+                op.write(op, state, out);
+                size_t length = out.size() - start;
+                if (op.maxWidth > 0 && length > op.maxWidth) {
+                    out.resize(start + op.maxWidth);
+                    length = op.maxWidth;
+                }
+                if (length < op.minWidth) {
+                    if (op.leftAlign) {
+                        out.append(op.minWidth - length, ' ');
+                    } else {
+                        out.insert(start, op.minWidth - length, ' ');
+                    }
+                }
+            }
+        }
+
+    private:
+        struct RenderState {
+            const LogEntry *entry;
+            std::tm time;
+            long subsecondNanos;
+        };
+
+        struct Op;
+        typedef void (*Writer)(const Op &, const RenderState &, std::string &);
+
+        struct Op {
+            Writer write;
+            std::string literal;
+            bool padded;
+            bool leftAlign;
+            size_t minWidth;
+            size_t maxWidth;
+        };
+
+        std::vector<Op> m_ops;
+        bool m_needsTime;
+
+        void compile(const std::string &pattern) {
+            std::string literal;
+            size_t i = 0;
+            while (i < pattern.size()) {
+                if (pattern[i] != '%' || i + 1 >= pattern.size()) {
+                    literal += pattern[i++];
+                    continue;
+                }
+                if (pattern[i + 1] == '%') {
+                    literal += '%';
+                    i += 2;
+                    continue;
+                }
+
+                size_t pos = i + 1;
+                Op op = Op();
+                if (pattern[pos] == '-') {
+                    op.leftAlign = true;
+                    ++pos;
+                }
+                pos = parseNumber(pattern, pos, op.minWidth);
+                if (pos < pattern.size() && pattern[pos] == '.') {
+                    pos = parseNumber(pattern, pos + 1, op.maxWidth);
+                }
+                op.padded = op.minWidth > 0 || op.maxWidth > 0;
+
+                size_t fieldLength = 0;
+                op.write = lookupWriter(pattern, pos, fieldLength);
+                if (!op.write) {
+                    literal += pattern[i++];
+                    continue;
+                }
+
+                flushLiteral(literal);
+                m_ops.push_back(op);
+                i = pos + fieldLength;
+            }
+            flushLiteral(literal);
+        }
+
+        void flushLiteral(std::string &literal) {
+            if (literal.empty()) {
+                return;
+            }
+            Op op = Op();
+            op.write = &writeLiteral;
+            op.literal.swap(literal);
+            m_ops.push_back(op);
+        }
+
+        static size_t parseNumber(const std::string &pattern, size_t pos, size_t &value) {
+            value = 0;
+            while (pos < pattern.size() && pattern[pos] >= '0' && pattern[pos] <= '9') {
+                value = value * 10 + static_cast<size_t>(pattern[pos] - '0');
+                ++pos;
+            }
+            return pos;
+        }
+
+        Writer lookupWriter(const std::string &pattern, size_t pos, size_t &fieldLength) {
+            if (pos >= pattern.size()) {
+                return nullptr;
+            }
+            if (pattern.compare(pos, 3, "ctx") == 0) {
+                fieldLength = 3;
+                return &writeContext;
+            }
+
+            fieldLength = 1;
+            switch (pattern[pos]) {
+                case 'v': return &writeMessage;
+                case 'T': return &writeTemplate;
+                case 'l': return &writeLevel;
+                case 'L': return &writeLevelAbbreviation;
+                case 't': return &writeThreadId;
+                case 's': return &writeFile;
+                case '#': return &writeLine;
+                case '!': return &writeFunction;
+                default: break;
+            }
+
+            Writer timeWriter = nullptr;
+            switch (pattern[pos]) {
+                case 'Y': timeWriter = &writeYear; break;
+                case 'm': timeWriter = &writeMonth; break;
+                case 'd': timeWriter = &writeDay; break;
+                case 'H': timeWriter = &writeHour; break;
+                case 'M': timeWriter = &writeMinute; break;
+                case 'S': timeWriter = &writeSecond; break;
+                case 'e': timeWriter = &writeMillis; break;
+                case 'f': timeWriter = &writeMicros; break;
+                case 'F': timeWriter = &writeNanos; break;
+                default: break;
+            }
+            if (timeWriter) {
+                m_needsTime = true;
+            }
+            return timeWriter;
+        }
+
+        static void appendDigits(std::string &out, long value, int digits) {
+            char buffer[16];
+            for (int i = digits - 1; i >= 0; --i) {
+                buffer[i] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+            out.append(buffer, static_cast<size_t>(digits));
+        }
+
+        static void writeLiteral(const Op &op, const RenderState &, std::string &out) {
+            out += op.literal;
+        }
+
+        static void writeMessage(const Op &, const RenderState &state, std::string &out) {
+            out += state.entry->message;
+        }
+
+        static void writeTemplate(const Op &, const RenderState &state, std::string &out) {
+            out += state.entry->templateStr;
+        }
+
+        static void writeLevel(const Op &, const RenderState &state, std::string &out) {
+            out += getLevelString(state.entry->level);
+        }
+
+        static void writeLevelAbbreviation(const Op &, const RenderState &state, std::string &out) {
+            out += getLevelAbbreviation(state.entry->level);
+        }
+
+        static void writeThreadId(const Op &, const RenderState &state, std::string &out) {
+            out += std::to_string(std::hash<std::thread::id>()(state.entry->threadId));
+        }
+
+        static void writeFile(const Op &, const RenderState &state, std::string &out) {
+            out += state.entry->file;
+        }
+
+        static void writeLine(const Op &, const RenderState &state, std::string &out) {
+            out += std::to_string(state.entry->line);
+        }
+
+        static void writeFunction(const Op &, const RenderState &state, std::string &out) {
+            out += state.entry->function;
+        }
+
+        static void writeContext(const Op &, const RenderState &state, std::string &out) {
+            const auto &context = state.entry->customContext;
+            if (context.empty()) {
+                return;
+            }
+            out += '{';
+            for (const auto &ctx : context) {
+                out += ctx.first;
+                out += '=';
+                out += ctx.second;
+                out += ", ";
+            }
+            out.resize(out.size() - 2);
+            out += '}';
+        }
+
+        static void writeYear(const Op &, const RenderState &state, std::string &out) {
+            appendDigits(out, state.time.tm_year + 1900, 4);
+        }
+
+        static void writeMonth(const Op &, const RenderState &state, std::string &out) {
+            appendDigits(out, state.time.tm_mon + 1, 2);
+        }
+
+        static void writeDay(const Op &, const RenderState &state, std::string &out) {
+            appendDigits(out, state.time.tm_mday, 2);
+        }
+
+        static void writeHour(const Op &, const RenderState &state, std::string &out) {
+            appendDigits(out, state.time.tm_hour, 2);
+        }
+
+        static void writeMinute(const Op &, const RenderState &state, std::string &out) {
+            appendDigits(out, state.time.tm_min, 2);
+        }
+
+        static void writeSecond(const Op &, const RenderState &state, std::string &out) {
+            appendDigits(out, state.time.tm_sec, 2);
+        }
+
+        static void writeMillis(const Op &, const RenderState &state, std::string &out) {
+            appendDigits(out, state.subsecondNanos / 1000000, 3);
+        }
+
+        static void writeMicros(const Op &, const RenderState &state, std::string &out) {
+            appendDigits(out, state.subsecondNanos / 1000, 6);
+        }
+
+        static void writeNanos(const Op &, const RenderState &state, std::string &out) {
+            appendDigits(out, state.subsecondNanos, 9);
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_PATTERN_FORMATTER_HPP
@@ -9,6 +9,10 @@
 namespace minta {
     class XmlFormatter : public IFormatter {
     public:
+        bool isStateless() const override {
+            return true;
+        }
+
         std::string format(const LogEntry &entry) const override {
             std::ostringstream xml;
             xml << "<log_entry>";
@@ -2,24 +2,309 @@
 #define LUNAR_LOG_MANAGER_HPP
 
 #include "sink/sink_interface.hpp"
+#include "core/log_common.hpp"
+#include "core/log_stats.hpp"
+#include "core/log_filter.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 namespace minta {
+    namespace detail {
+        inline size_t lowestSetBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_t>(__builtin_ctzll(word));
+#else
+            size_t index = 0;
+            while ((word & 1) == 0) {
+                word >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+    } // namespace detail
+
+    // Sinks are published as immutable snapshots. Writers copy the current
+    // snapshot, change the copy and swap it in atomically; the worker loads a
+    // snapshot once per batch and never blocks on writers. A removed sink stays
+    // alive until the last snapshot that refers to it is released.
     class LogManager {
     public:
-        void addSink(std::unique_ptr<ISink> sink) {
-            m_sinks.push_back(std::move(sink));
+        struct SinkSlot {
+            SinkId id;
+            std::shared_ptr<ISink> sink;
+            LogLevel minLevel;
+            // Tags the sink is restricted to; empty accepts every entry.
+            std::vector<std::string> tags;
+            std::shared_ptr<const LogFilter> filter;
+            std::shared_ptr<SinkCounters> counters;
+        };
+
+        enum { LevelCount = 6 };
+
+        // Maps (tag, level) to the set of sinks that accept it, rebuilt whenever a
+        // snapshot is published. Row 0 holds untagged entries and tags no sink is
+        // restricted to; row i + 1 holds tags[i]. Each row has one bitset of
+        // `words` 64-bit words per level, bit n standing for sinks[n].
+        struct RoutingTable {
+            RoutingTable() : words(0) {
+            }
+
+            std::vector<std::string> tags;
+            // Tag to row; tags no sink is restricted to are absent and use row 0.
+            std::unordered_map<std::string, size_t> rows;
+            size_t words;
+            std::vector<uint64_t> bits;
+
+            const uint64_t *route(const std::string &tag, LogLevel level) const {
+                size_t row = 0;
+                if (!tag.empty()) {
+                    auto it = rows.find(tag);
+                    if (it != rows.end()) {
+                        row = it->second;
+                    }
+                }
+                return bits.data() + (row * LevelCount + static_cast<size_t>(level)) * words;
+            }
+        };
+
+        struct Snapshot {
+            std::vector<SinkSlot> sinks;
+            std::shared_ptr<const LogFilter> filter;
+            RoutingTable routes;
+        };
+
+        LogManager() : m_snapshot(std::make_shared<const Snapshot>()), m_nextId(1) {
+        }
+
+        std::shared_ptr<const Snapshot> snapshot() const {
+            return std::atomic_load(&m_snapshot);
+        }
+
+        SinkId addSink(std::unique_ptr<ISink> sink) {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            SinkId id = m_nextId++;
+            SinkSlot slot;
+            slot.id = id;
+            slot.sink = std::shared_ptr<ISink>(std::move(sink));
+            slot.minLevel = LogLevel::TRACE;
+            slot.counters = std::make_shared<SinkCounters>();
+            auto next = std::make_shared<Snapshot>(*snapshot());
+            next->sinks.push_back(std::move(slot));
+            publish(std::move(next));
+            return id;
+        }
+
+        bool removeSink(SinkId id) {
+            return update(id, [](std::vector<SinkSlot> &sinks, std::vector<SinkSlot>::iterator slot) {
+                sinks.erase(slot);
+            });
+        }
+
+        // The new sink keeps the old one's id, level, filter and statistics.
+        bool replaceSink(SinkId id, std::unique_ptr<ISink> sink) {
+            std::shared_ptr<ISink> replacement(std::move(sink));
+            return update(id, [&replacement](std::vector<SinkSlot> &, std::vector<SinkSlot>::iterator slot) {
+                slot->sink = replacement;
+            });
+        }
+
+        // Entries below the sink's level skip it before any formatting happens.
+        bool setSinkMinLevel(SinkId id, LogLevel level) {
+            return update(id, [level](std::vector<SinkSlot> &, std::vector<SinkSlot>::iterator slot) {
+                slot->minLevel = level;
+            });
+        }
+
+        bool setSinkTags(SinkId id, const std::vector<std::string> &tags) {
+            return update(id, [&tags](std::vector<SinkSlot> &, std::vector<SinkSlot>::iterator slot) {
+                slot->tags = tags;
+            });
+        }
+
+        bool setSinkFilter(SinkId id, std::shared_ptr<const LogFilter> filter) {
+            return update(id, [&filter](std::vector<SinkSlot> &, std::vector<SinkSlot>::iterator slot) {
+                slot->filter = filter;
+            });
+        }
+
+        void setFilter(std::shared_ptr<const LogFilter> filter) {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            auto next = std::make_shared<Snapshot>(*snapshot());
+            next->filter = std::move(filter);
+            publish(std::move(next));
+        }
+
+        bool getSinkMinLevel(SinkId id, LogLevel &level) const {
+            std::shared_ptr<const Snapshot> current = snapshot();
+            for (const auto &slot: current->sinks) {
+                if (slot.id == id) {
+                    level = slot.minLevel;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool usesFormatter(const IFormatter *formatter) const {
+            std::shared_ptr<const Snapshot> current = snapshot();
+            for (const auto &slot: current->sinks) {
+                if (slot.sink->getFormatter() == formatter) {
+                    return true;
+                }
+            }
+            return false;
         }
 
-        void log(const LogEntry &entry) {
-            for (const auto &sink: m_sinks) {
-                sink->write(entry);
+        // The lowest level any sink accepts; TRACE while there are no sinks, so
+        // entries logged before the first sink is added are not lost.
+        LogLevel lowestSinkLevel() const {
+            std::shared_ptr<const Snapshot> current = snapshot();
+            if (current->sinks.empty()) {
+                return LogLevel::TRACE;
             }
+            LogLevel lowest = LogLevel::FATAL;
+            for (const auto &slot: current->sinks) {
+                lowest = std::min(lowest, slot.minLevel);
+            }
+            return lowest;
+        }
+
+        uint64_t log(const LogEntry &entry) {
+            return log(*snapshot(), entry);
+        }
+
+        // Returns the formatted bytes handed to sinks. With bypassLevels the entry
+        // goes to every sink whose tags accept it, whatever the sink's level. Only
+        // the worker thread calls this.
+        uint64_t log(const Snapshot &current, const LogEntry &entry, bool bypassLevels = false) {
+            if (current.filter && !current.filter->matches(entry)) {
+                return 0;
+            }
+            uint64_t totalBytes = 0;
+            m_formatCache.clear();
+            const uint64_t *route = current.routes.route(entry.tag, bypassLevels ? LogLevel::FATAL : entry.level);
+            for (size_t word = 0; word < current.routes.words; ++word) {
+                for (uint64_t bits = route[word]; bits != 0; bits &= bits - 1) {
+                    const SinkSlot &slot = current.sinks[word * 64 + detail::lowestSetBit(bits)];
+                    if (!slot.filter || slot.filter->matches(entry)) {
+                        totalBytes += write(slot, entry);
+                    }
+                }
+            }
+            return totalBytes;
+        }
+
+        std::vector<SinkStats> sinkStats() const {
+            std::shared_ptr<const Snapshot> current = snapshot();
+            std::vector<SinkStats> stats;
+            stats.reserve(current->sinks.size());
+            for (const auto &slot: current->sinks) {
+                stats.push_back(slot.counters->snapshot());
+                stats.back().id = slot.id;
+            }
+            return stats;
         }
 
     private:
-        std::vector<std::unique_ptr<ISink> > m_sinks;
+        std::shared_ptr<const Snapshot> m_snapshot;
+        std::mutex m_writeMutex;
+        SinkId m_nextId;
+        std::vector<std::pair<const IFormatter *, std::string> > m_formatCache;
+
+        uint64_t write(const SinkSlot &slot, const LogEntry &entry) {
+            ISink &sink = *slot.sink;
+            auto start = std::chrono::steady_clock::now();
+            uint64_t bytes = 0;
+            const IFormatter *formatter = sink.getFormatter();
+            // A failing sink must not take down the worker thread or the other sinks.
+            try {
+                if (formatter && sink.acceptsFormattedOutput() && formatter->isStateless()) {
+                    const std::string &formatted = formatOnce(formatter, entry);
+                    bytes = formatted.size();
+                    sink.writeFormatted(entry, formatted);
+                } else if (formatter && sink.acceptsFormattedOutput()) {
+                    std::string formatted = formatter->format(entry);
+                    bytes = formatted.size();
+                    sink.writeFormatted(entry, formatted);
+                } else {
+                    sink.write(entry);
+                }
+            } catch (const std::exception &) {
+                slot.counters->recordError();
+                return 0;
+            }
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            slot.counters->record(bytes, static_cast<uint64_t>(elapsed));
+            return bytes;
+        }
+
+        static void buildRoutes(Snapshot &snapshot) {
+            RoutingTable &routes = snapshot.routes;
+            routes.tags.clear();
+            routes.rows.clear();
+            for (const auto &slot: snapshot.sinks) {
+                for (const auto &tag: slot.tags) {
+                    if (routes.rows.emplace(tag, routes.tags.size() + 1).second) {
+                        routes.tags.push_back(tag);
+                    }
+                }
+            }
+            routes.words = (snapshot.sinks.size() + 63) / 64;
+            routes.bits.assign((routes.tags.size() + 1) * LevelCount * routes.words, 0);
+            for (size_t n = 0; n < snapshot.sinks.size(); ++n) {
+                const SinkSlot &slot = snapshot.sinks[n];
+                for (size_t row = 0; row <= routes.tags.size(); ++row) {
+                    bool accepted = slot.tags.empty() ||
+                                    (row > 0 && std::find(slot.tags.begin(), slot.tags.end(), routes.tags[row - 1]) != slot.tags.end());
+                    if (!accepted) continue;
+                    for (size_t level = static_cast<size_t>(slot.minLevel); level < LevelCount; ++level) {
+                        routes.bits[(row * LevelCount + level) * routes.words + n / 64] |= uint64_t(1) << (n % 64);
+                    }
+                }
+            }
+        }
+
+        void publish(std::shared_ptr<Snapshot> next) {
+            buildRoutes(*next);
+            std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::move(next)));
+        }
+
+        // Copies the current snapshot, applies `modify` to the slot with the given
+        // id and publishes the copy; returns false if no sink has that id.
+        template<typename Modify>
+        bool update(SinkId id, Modify modify) {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            auto next = std::make_shared<Snapshot>(*snapshot());
+            for (auto it = next->sinks.begin(); it != next->sinks.end(); ++it) {
+                if (it->id == id) {
+                    modify(next->sinks, it);
+                    publish(std::move(next));
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        const std::string &formatOnce(const IFormatter *formatter, const LogEntry &entry) {
+            for (const auto &cached: m_formatCache) {
+                if (cached.first == formatter) {
+                    return cached.second;
+                }
+            }
+            m_formatCache.emplace_back(formatter, formatter->format(entry));
+            return m_formatCache.back().second;
+        }
     };
 } // namespace minta
 
@@ -2,34 +2,54 @@
 #define LUNAR_LOG_SOURCE_HPP
 
 #include "core/log_entry.hpp"
+#include "core/log_stats.hpp"
+#include "core/template_profiler.hpp"
+#include "core/backtrace_buffer.hpp"
 #include "log_manager.hpp"
 #include "sink/console_sink.hpp"
 #include "formatter/human_readable_formatter.hpp"
 #include <atomic>
 #include <thread>
-#include <queue>
+#include <vector>
 #include <mutex>
 #include <condition_variable>
-#include <regex>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
 #include <type_traits>
-#include <set>
 #include <map>
 
 namespace minta {
     class LunarLog {
     public:
-        LunarLog(LogLevel minLevel = LogLevel::INFO)
+        LunarLog(LogLevel minLevel = LogLevel::INFO, bool addDefaultSink = true)
             : m_minLevel(minLevel)
+            , m_gateLevel(minLevel)
             , m_isRunning(true)
-            , m_lastLogTime(std::chrono::steady_clock::now())
+            , m_windowStart(std::chrono::steady_clock::now().time_since_epoch().count())
             , m_logCount(0)
+            , m_rateLimit(1000)
+            , m_maxQueueSize(0)
+            , m_enqueued(0)
+            , m_droppedRateLimited(0)
+            , m_droppedOverflow(0)
+            , m_queueHighWater(0)
+            , m_workerBusyNanos(0)
+            , m_statsIntervalMs(0)
+            , m_profiling(false)
+            , m_backtraceTrigger(LogLevel::ERROR)
             , m_captureContext(false) {
-            addSink<ConsoleSink>();
+            if (addDefaultSink) {
+                addSink<ConsoleSink>();
+            }
             m_logThread = std::thread(&LunarLog::processLogQueue, this);
         }
 
         ~LunarLog() {
-            m_isRunning = false;
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                m_isRunning = false;
+            }
             m_logCV.notify_one();
             if (m_logThread.joinable()) {
                 m_logThread.join();
@@ -42,11 +62,13 @@ namespace minta {
         LunarLog &operator=(LunarLog &&) = delete;
 
         void setMinLevel(LogLevel level) {
-            m_minLevel = level;
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            m_minLevel.store(level, std::memory_order_relaxed);
+            updateGateLevel();
         }
 
         LogLevel getMinLevel() const {
-            return m_minLevel;
+            return m_minLevel.load(std::memory_order_relaxed);
         }
 
         void setCaptureContext(bool capture) {
@@ -57,34 +79,189 @@ namespace minta {
             return m_captureContext;
         }
 
+        // Maximum entries accepted per second; 0 disables rate limiting.
+        void setRateLimit(size_t entriesPerSecond) {
+            m_rateLimit.store(entriesPerSecond, std::memory_order_relaxed);
+        }
+
+        size_t getRateLimit() const {
+            return m_rateLimit.load(std::memory_order_relaxed);
+        }
+
+        // Maximum number of entries waiting for the worker; entries beyond it are
+        // dropped and counted. 0 (the default) leaves the queue unbounded.
+        void setMaxQueueSize(size_t maxEntries) {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_maxQueueSize = maxEntries;
+        }
+
+        LogStats getStats() {
+            LogStats stats;
+            stats.enqueued = m_enqueued.load(std::memory_order_relaxed);
+            stats.droppedRateLimited = m_droppedRateLimited.load(std::memory_order_relaxed);
+            stats.droppedOverflow = m_droppedOverflow.load(std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                stats.queueDepth = m_logQueue.size();
+            }
+            stats.queueHighWater = m_queueHighWater.load(std::memory_order_relaxed);
+            stats.workerBusyNanos = m_workerBusyNanos.load(std::memory_order_relaxed);
+            stats.sinks = m_logManager.sinkStats();
+            return stats;
+        }
+
+        // Profiling records, per message template, the number of calls, the time
+        // spent in the logging call and on the worker, and the bytes produced.
+        void setProfiling(bool enabled) {
+            m_profiling = enabled;
+        }
+
+        bool getProfiling() const {
+            return m_profiling;
+        }
+
+        std::vector<TemplateProfile> getProfile(ProfileOrder order = ProfileOrder::TotalTime) const {
+            return m_profiler.report(order);
+        }
+
+        std::string profileReport(size_t limit = 20, ProfileOrder order = ProfileOrder::TotalTime) const {
+            return TemplateProfiler::formatReport(m_profiler.report(order), limit);
+        }
+
+        void resetProfile() {
+            m_profiler.reset();
+        }
+
+        // Keeps the last `capacity` calls that pass setMinLevel but no sink's level
+        // in memory, unrendered, with the context set when they were made. When an entry at or above `trigger` is logged,
+        // they are written ahead of it to every sink, ignoring sink levels. A
+        // trigger that no sink accepts is buffered and written out along with them.
+        // A capacity of 0 turns the backtrace off.
+        void setBacktrace(size_t capacity, LogLevel trigger = LogLevel::ERROR) {
+            m_backtraceTrigger = trigger;
+            m_backtrace.setCapacity(capacity);
+        }
+
+        // Writes out the buffered backtrace now.
+        void dumpBacktrace() {
+            std::vector<LogEntry> entries = renderBacktrace(m_backtrace.drain());
+            if (entries.empty()) return;
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                enqueueBacktrace(entries);
+            }
+            m_logCV.notify_one();
+        }
+
+        // When non-zero, the worker writes a stats entry to every sink at this interval.
+        void setStatsInterval(std::chrono::milliseconds interval) {
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                m_statsIntervalMs = interval.count();
+            }
+            m_logCV.notify_one();
+        }
+
         template<typename SinkType, typename... Args>
-        typename std::enable_if<std::is_base_of<ISink, SinkType>::value>::type
+        typename std::enable_if<std::is_base_of<ISink, SinkType>::value, SinkId>::type
         addSink(Args &&... args) {
             auto sink = make_unique<SinkType>(std::forward<Args>(args)...);
-            sink->setFormatter(make_unique<HumanReadableFormatter>());
-            m_logManager.addSink(std::move(sink));
+            if (!sink->getFormatter()) {
+                sink->setFormatter(make_unique<HumanReadableFormatter>());
+            }
+            return addCustomSink(std::move(sink));
         }
 
         template<typename SinkType, typename FormatterType, typename... Args>
-        typename std::enable_if<std::is_base_of<ISink, SinkType>::value && std::is_base_of<IFormatter, FormatterType>::value>::type
+        typename std::enable_if<std::is_base_of<ISink, SinkType>::value && std::is_base_of<IFormatter, FormatterType>::value, SinkId>::type
         addSink(Args &&... args) {
             auto sink = make_unique<SinkType>(std::forward<Args>(args)...);
             sink->setFormatter(make_unique<FormatterType>());
-            m_logManager.addSink(std::move(sink));
+            return addCustomSink(std::move(sink));
         }
 
-        void addCustomSink(std::unique_ptr<ISink> sink) {
-            m_logManager.addSink(std::move(sink));
+        // Throws std::invalid_argument when a formatter that is not stateless
+        // is already in use by another sink.
+        template<typename SinkType, typename... Args>
+        typename std::enable_if<std::is_base_of<ISink, SinkType>::value, SinkId>::type
+        addSinkWithFormatter(std::shared_ptr<IFormatter> formatter, Args &&... args) {
+            auto sink = make_unique<SinkType>(std::forward<Args>(args)...);
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            if (formatter && !formatter->isStateless() && m_logManager.usesFormatter(formatter.get())) {
+                throw std::invalid_argument("LunarLog: a stateful formatter cannot be shared between sinks");
+            }
+            sink->setFormatter(std::move(formatter));
+            SinkId id = m_logManager.addSink(std::move(sink));
+            updateGateLevel();
+            return id;
+        }
+
+        SinkId addCustomSink(std::unique_ptr<ISink> sink) {
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            SinkId id = m_logManager.addSink(std::move(sink));
+            updateGateLevel();
+            return id;
+        }
+
+        // Sinks can be added, removed and replaced while other threads log. The
+        // worker may finish its current batch on a removed or replaced sink; the
+        // old sink is destroyed once that batch is done.
+        bool removeSink(SinkId id) {
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            bool found = m_logManager.removeSink(id);
+            updateGateLevel();
+            return found;
+        }
+
+        // The replacement keeps the id, level, filter and statistics of the old sink.
+        bool replaceSink(SinkId id, std::unique_ptr<ISink> sink) {
+            return m_logManager.replaceSink(id, std::move(sink));
+        }
+
+        // Entries below a sink's level are not formatted for it. Calls below every
+        // sink's level return before any work, as if below setMinLevel.
+        bool setSinkMinLevel(SinkId id, LogLevel level) {
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            bool found = m_logManager.setSinkMinLevel(id, level);
+            updateGateLevel();
+            return found;
+        }
+
+        bool getSinkMinLevel(SinkId id, LogLevel &level) const {
+            return m_logManager.getSinkMinLevel(id, level);
+        }
+
+        // Only entries matching the filter expression (see LogFilter) reach the
+        // sinks. The expression is compiled here and evaluated on the worker
+        // thread; an empty expression removes the filter. Throws
+        // std::invalid_argument if the expression does not parse.
+        void setFilter(const std::string &expression) {
+            m_logManager.setFilter(compileFilter(expression));
+        }
+
+        bool setSinkFilter(SinkId id, const std::string &expression) {
+            return m_logManager.setSinkFilter(id, compileFilter(expression));
+        }
+
+        // Restricts a sink to entries logged with one of the given tags; an empty
+        // list makes it accept every entry again.
+        bool setSinkTags(SinkId id, const std::vector<std::string> &tags) {
+            return m_logManager.setSinkTags(id, tags);
         }
 
         template<typename... Args>
         void log(LogLevel level, const std::string &messageTemplate, const Args &... args) {
-            logInternal(level, "", 0, "", messageTemplate, args...);
+            logInternal(level, "", "", 0, "", messageTemplate, args...);
+        }
+
+        template<typename... Args>
+        void logTagged(const std::string &tag, LogLevel level, const std::string &messageTemplate, const Args &... args) {
+            logInternal(level, tag.c_str(), "", 0, "", messageTemplate, args...);
         }
 
         template<typename... Args>
         void logWithContext(LogLevel level, const char* file, int line, const char* function, const std::string &messageTemplate, const Args &... args) {
-            logInternal(level, file, line, function, messageTemplate, args...);
+            logInternal(level, "", file, line, function, messageTemplate, args...);
         }
 
         template<typename... Args>
@@ -133,31 +310,78 @@ namespace minta {
         }
 
     private:
-        LogLevel m_minLevel;
+        std::atomic<LogLevel> m_minLevel;
+        // The stricter of m_minLevel and the lowest sink level, checked on every call.
+        std::atomic<LogLevel> m_gateLevel;
         std::atomic<bool> m_isRunning;
-        std::chrono::steady_clock::time_point m_lastLogTime;
+        // Start of the current rate-limit window, in steady_clock ticks.
+        std::atomic<std::chrono::steady_clock::rep> m_windowStart;
         std::atomic<size_t> m_logCount;
+        std::atomic<size_t> m_rateLimit;
+        size_t m_maxQueueSize;
+        std::atomic<uint64_t> m_enqueued;
+        std::atomic<uint64_t> m_droppedRateLimited;
+        std::atomic<uint64_t> m_droppedOverflow;
+        std::atomic<size_t> m_queueHighWater;
+        std::atomic<uint64_t> m_workerBusyNanos;
+        std::atomic<long long> m_statsIntervalMs;
+        std::atomic<bool> m_profiling;
+        TemplateProfiler m_profiler;
+        BacktraceBuffer m_backtrace;
+        std::atomic<LogLevel> m_backtraceTrigger;
         std::mutex m_queueMutex;
         std::mutex m_contextMutex;
+        std::mutex m_sinkMutex;
         std::condition_variable m_logCV;
-        std::queue<LogEntry> m_logQueue;
+        // Backtrace entries bypass sink levels on their way to the sinks.
+        struct QueuedEntry {
+            LogEntry entry;
+            bool fromBacktrace;
+        };
+
+        std::vector<QueuedEntry> m_logQueue;
         std::thread m_logThread;
         LogManager m_logManager;
         std::map<std::string, std::string> m_customContext;
         bool m_captureContext;
 
         template<typename... Args>
-        void logInternal(LogLevel level, const char* file, int line, const char* function, const std::string &messageTemplate, const Args &... args) {
-            if (level < m_minLevel) return;
-            if (!rateLimitCheck()) return;
+        void logInternal(LogLevel level, const char* tag, const char* file, int line, const char* function, const std::string &messageTemplate, const Args &... args) {
+            if (level < m_gateLevel.load(std::memory_order_relaxed)) {
+                if (m_backtrace.capacity() != 0 && level >= m_minLevel.load(std::memory_order_relaxed)) {
+                    std::vector<std::string> values{toString(args)...};
+                    std::map<std::string, std::string> context;
+                    {
+                        std::lock_guard<std::mutex> contextLock(m_contextMutex);
+                        context = m_customContext;
+                    }
+                    m_backtrace.push(level, tag, m_captureContext ? file : "", m_captureContext ? line : 0,
+                                     m_captureContext ? function : "", messageTemplate, values, context);
+                    // A trigger below every sink level still flushes the ring, itself included.
+                    if (level >= m_backtraceTrigger.load(std::memory_order_relaxed)) {
+                        dumpBacktrace();
+                    }
+                }
+                return;
+            }
+            if (!rateLimitCheck()) {
+                m_droppedRateLimited.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::vector<LogEntry> backtrace;
+            if (level >= m_backtraceTrigger.load(std::memory_order_relaxed) && m_backtrace.capacity() != 0) {
+                backtrace = renderBacktrace(m_backtrace.drain());
+            }
+            bool profiling = m_profiling.load(std::memory_order_relaxed);
+            auto callStart = profiling ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
 
-            auto validationResult = validatePlaceholders(messageTemplate, args...);
-            std::string validatedTemplate = validationResult.first;
-            std::vector<std::string> warnings = validationResult.second;
+            std::vector<std::string> values{toString(args)...};
+            std::vector<std::string> warnings = validatePlaceholders(messageTemplate, values);
 
             auto now = std::chrono::system_clock::now();
-            std::string message = formatMessage(validatedTemplate, args...);
-            auto argumentPairs = mapArgumentsToPlaceholders(validatedTemplate, args...);
+            auto threadId = std::this_thread::get_id();
+            std::string message = renderMessageTemplate(messageTemplate, values);
+            auto argumentPairs = mapArgumentsToPlaceholders(messageTemplate, values);
 
             std::unique_lock<std::mutex> lock(m_queueMutex);
             std::map<std::string, std::string> contextCopy;
@@ -166,81 +390,225 @@ namespace minta {
                 contextCopy = m_customContext;
             }
 
-            m_logQueue.emplace(LogEntry{
-                level, std::move(message), now, validatedTemplate, std::move(argumentPairs),
-                m_captureContext ? file : "", m_captureContext ? line : 0, m_captureContext ? function : "", std::move(contextCopy)
-            });
+            enqueueBacktrace(backtrace);
+            if (!reserveQueueSlot()) return;
+            m_logQueue.push_back(QueuedEntry{LogEntry{
+                level, std::move(message), now, messageTemplate, std::move(argumentPairs),
+                m_captureContext ? file : "", m_captureContext ? line : 0, m_captureContext ? function : "", std::move(contextCopy), threadId, tag
+            }, false});
 
             for (const auto& warning : warnings) {
-                m_logQueue.emplace(LogEntry{LogLevel::WARN, warning, now, warning, {},
-                                            m_captureContext ? file : "", m_captureContext ? line : 0, m_captureContext ? function : "", {}});
+                if (!reserveQueueSlot()) break;
+                m_logQueue.push_back(QueuedEntry{LogEntry{LogLevel::WARN, warning, now, warning, {},
+                                                 m_captureContext ? file : "", m_captureContext ? line : 0, m_captureContext ? function : "", {}, threadId, tag}, false});
             }
 
+            size_t depth = m_logQueue.size();
+            if (depth > m_queueHighWater.load(std::memory_order_relaxed)) {
+                m_queueHighWater.store(depth, std::memory_order_relaxed);
+            }
             lock.unlock();
             m_logCV.notify_one();
+
+            if (profiling) {
+                m_profiler.recordCall(messageTemplate, elapsedNanos(callStart));
+            }
+        }
+
+        static uint64_t elapsedNanos(std::chrono::steady_clock::time_point start) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
         }
 
+        static std::shared_ptr<const LogFilter> compileFilter(const std::string &expression) {
+            if (expression.empty()) {
+                return nullptr;
+            }
+            return std::make_shared<const LogFilter>(expression);
+        }
+
+        // Called with m_sinkMutex held, so concurrent sink changes cannot publish a stale gate.
+        void updateGateLevel() {
+            m_gateLevel.store(std::max(m_minLevel.load(std::memory_order_relaxed), m_logManager.lowestSinkLevel()), std::memory_order_relaxed);
+        }
+
+        static std::vector<LogEntry> renderBacktrace(std::vector<BacktraceRecord> records) {
+            std::vector<LogEntry> entries;
+            entries.reserve(records.size());
+            for (auto &record : records) {
+                LogEntry entry;
+                entry.level = record.level;
+                entry.message = renderMessageTemplate(record.templateStr, record.values);
+                entry.timestamp = record.timestamp;
+                entry.arguments = mapArgumentsToPlaceholders(record.templateStr, record.values);
+                entry.templateStr = std::move(record.templateStr);
+                entry.file = std::move(record.file);
+                entry.line = record.line;
+                entry.function = std::move(record.function);
+                entry.threadId = record.threadId;
+                entry.tag = std::move(record.tag);
+                entry.customContext = std::move(record.customContext);
+                entries.push_back(std::move(entry));
+            }
+            return entries;
+        }
+
+        // Called with m_queueMutex held.
+        void enqueueBacktrace(std::vector<LogEntry> &entries) {
+            for (auto &entry : entries) {
+                if (!reserveQueueSlot()) break;
+                m_logQueue.push_back(QueuedEntry{std::move(entry), true});
+            }
+        }
+
+        // Called with m_queueMutex held.
+        bool reserveQueueSlot() {
+            if (m_maxQueueSize != 0 && m_logQueue.size() >= m_maxQueueSize) {
+                m_droppedOverflow.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_enqueued.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Takes the whole queue at once; both vectors keep their capacity, so a
+        // steady stream of entries does not reallocate queue storage.
         void processLogQueue() {
-            while (m_isRunning) {
-                std::unique_lock<std::mutex> lock(m_queueMutex);
-                m_logCV.wait(lock, [this] { return !m_logQueue.empty() || !m_isRunning; });
+            std::vector<QueuedEntry> batch;
+            bool statsScheduled = false;
+            auto nextStats = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            while (true) {
+                std::chrono::milliseconds statsInterval(m_statsIntervalMs.load());
+                if (statsInterval.count() > 0 && !statsScheduled) {
+                    nextStats = std::chrono::steady_clock::now() + statsInterval;
+                }
+                statsScheduled = statsInterval.count() > 0;
+
+                auto ready = [this, statsScheduled] {
+                    return !m_logQueue.empty() || !m_isRunning || (m_statsIntervalMs.load() > 0) != statsScheduled;
+                };
+                if (statsScheduled) {
+                    m_logCV.wait_until(lock, nextStats, ready);
+                } else {
+                    m_logCV.wait(lock, ready);
+                }
 
                 while (!m_logQueue.empty()) {
-                    auto entry = std::move(m_logQueue.front());
-                    m_logQueue.pop();
+                    batch.swap(m_logQueue);
                     lock.unlock();
 
-                    m_logManager.log(entry);
+                    auto start = std::chrono::steady_clock::now();
+                    std::shared_ptr<const LogManager::Snapshot> sinks = m_logManager.snapshot();
+                    if (m_profiling.load(std::memory_order_relaxed)) {
+                        for (const auto &queued : batch) {
+                            auto entryStart = std::chrono::steady_clock::now();
+                            uint64_t bytes = m_logManager.log(*sinks, queued.entry, queued.fromBacktrace);
+                            m_profiler.recordWrite(queued.entry.templateStr, bytes, elapsedNanos(entryStart));
+                        }
+                    } else {
+                        for (const auto &queued : batch) {
+                            m_logManager.log(*sinks, queued.entry, queued.fromBacktrace);
+                        }
+                    }
+                    sinks.reset();
+                    batch.clear();
+                    m_workerBusyNanos.fetch_add(elapsedNanos(start), std::memory_order_relaxed);
+
+                    lock.lock();
+                }
 
+                auto now = std::chrono::steady_clock::now();
+                if (statsScheduled && now >= nextStats) {
+                    lock.unlock();
+                    m_logManager.log(makeStatsEntry());
                     lock.lock();
+                    nextStats = now + statsInterval;
+                }
+
+                if (!m_isRunning) {
+                    break;
                 }
             }
         }
 
+        LogEntry makeStatsEntry() {
+            LogStats stats = getStats();
+            std::vector<std::string> values{
+                std::to_string(stats.enqueued), std::to_string(stats.droppedRateLimited),
+                std::to_string(stats.droppedOverflow), std::to_string(stats.queueHighWater),
+                std::to_string(stats.workerBusyNanos / 1000000)
+            };
+            static const std::string statsTemplate =
+                "LunarLog stats: enqueued={enqueued} dropped_rate_limited={droppedRateLimited} "
+                "dropped_overflow={droppedOverflow} queue_high_water={queueHighWater} worker_busy_ms={workerBusyMs}";
+
+            LogEntry entry;
+            entry.level = LogLevel::INFO;
+            entry.message = renderMessageTemplate(statsTemplate, values);
+            entry.timestamp = std::chrono::system_clock::now();
+            entry.templateStr = statsTemplate;
+            entry.arguments = mapArgumentsToPlaceholders(statsTemplate, values);
+            entry.line = 0;
+            entry.threadId = std::this_thread::get_id();
+            return entry;
+        }
+
         bool rateLimitCheck() {
-            auto now = std::chrono::steady_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - m_lastLogTime).count();
-            if (duration >= 1) {
-                m_lastLogTime = now;
-                m_logCount = 1;
+            size_t rateLimit = m_rateLimit.load(std::memory_order_relaxed);
+            if (rateLimit == 0) {
                 return true;
             }
-            if (m_logCount >= 1000) {
-                return false;
+            const std::chrono::steady_clock::rep window =
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1)).count();
+            std::chrono::steady_clock::rep now = std::chrono::steady_clock::now().time_since_epoch().count();
+            std::chrono::steady_clock::rep windowStart = m_windowStart.load(std::memory_order_relaxed);
+            // One thread wins the race to open the next window; the others count against it.
+            if (now - windowStart >= window &&
+                m_windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed)) {
+                m_logCount.store(1, std::memory_order_relaxed);
+                return true;
             }
-            ++m_logCount;
-            return true;
+            return m_logCount.fetch_add(1, std::memory_order_relaxed) < rateLimit;
         }
 
-        template<typename... Args>
-        static std::pair<std::string, std::vector<std::string>> validatePlaceholders(
-            const std::string &messageTemplate, const Args &... args) {
-            std::vector<std::string> warnings;
-            std::vector<std::string> placeholders;
-            std::set<std::string> uniquePlaceholders;
-            std::vector<std::string> values{toString(args)...};
-
-            std::regex placeholderRegex(R"(\{([^{}]*)\})");
-            auto placeholderBegin = std::sregex_iterator(messageTemplate.begin(), messageTemplate.end(),
-                                                         placeholderRegex);
-            auto placeholderEnd = std::sregex_iterator();
-
-            for (std::sregex_iterator i = placeholderBegin; i != placeholderEnd; ++i) {
-                std::smatch match = *i;
-                std::string placeholder = match[1].str();
-
-                if (placeholder.empty() && match.prefix().str().back() == '{') {
+        // Calls visit(name) for every {name} placeholder, skipping the empty
+        // "{}" inside an escaped "{{}}".
+        template<typename Visitor>
+        static void forEachPlaceholder(const std::string &messageTemplate, Visitor visit) {
+            size_t searchFrom = 0;
+            size_t open = messageTemplate.find('{');
+            while (open != std::string::npos) {
+                size_t close = messageTemplate.find_first_of("{}", open + 1);
+                if (close == std::string::npos) {
+                    return;
+                }
+                if (messageTemplate[close] == '{') {
+                    open = close;
                     continue;
                 }
+                bool escapedEmpty = close == open + 1 && open > searchFrom && messageTemplate[open - 1] == '{';
+                if (!escapedEmpty) {
+                    visit(messageTemplate.substr(open + 1, close - open - 1));
+                }
+                searchFrom = close + 1;
+                open = messageTemplate.find('{', searchFrom);
+            }
+        }
 
-                placeholders.push_back(placeholder);
+        static std::vector<std::string> validatePlaceholders(const std::string &messageTemplate,
+                                                             const std::vector<std::string> &values) {
+            std::vector<std::string> warnings;
+            std::vector<std::string> placeholders;
 
+            forEachPlaceholder(messageTemplate, [&](std::string placeholder) {
                 if (placeholder.empty()) {
                     warnings.push_back("Warning: Empty placeholder found");
-                } else if (!uniquePlaceholders.insert(placeholder).second) {
+                } else if (std::find(placeholders.begin(), placeholders.end(), placeholder) != placeholders.end()) {
                     warnings.push_back("Warning: Repeated placeholder name: " + placeholder);
                 }
-            }
+                placeholders.push_back(std::move(placeholder));
+            });
 
             if (placeholders.size() < values.size()) {
                 warnings.push_back("Warning: More values provided than placeholders");
@@ -248,7 +616,7 @@ namespace minta {
                 warnings.push_back("Warning: More placeholders than provided values");
             }
 
-            return std::make_pair(messageTemplate, warnings);
+            return warnings;
         }
 
         template<typename T>
@@ -258,67 +626,23 @@ namespace minta {
             return oss.str();
         }
 
-        template<typename... Args>
-        static std::string formatMessage(const std::string &messageTemplate, const Args &... args) {
-            std::vector<std::string> values{toString(args)...};
-            std::string result;
-            result.reserve(messageTemplate.length());
-            size_t valueIndex = 0;
+        static std::string toString(const std::string &value) {
+            return value;
+        }
 
-            for (size_t i = 0; i < messageTemplate.length(); ++i) {
-                if (messageTemplate[i] == '{') {
-                    if (i + 1 < messageTemplate.length() && messageTemplate[i + 1] == '{') {
-                        result += '{';
-                        ++i;
-                    } else {
-                        size_t endPos = messageTemplate.find("}", i);
-                        if (endPos == std::string::npos) {
-                            result += messageTemplate[i];
-                        } else if (valueIndex < values.size()) {
-                            result += values[valueIndex++];
-                            i = endPos;
-                        } else {
-                            result += messageTemplate.substr(i, endPos - i + 1);
-                            i = endPos;
-                        }
-                    }
-                } else if (messageTemplate[i] == '}') {
-                    if (i + 1 < messageTemplate.length() && messageTemplate[i + 1] == '}') {
-                        result += '}';
-                        ++i;
-                    } else {
-                        result += messageTemplate[i];
-                    }
-                } else {
-                    result += messageTemplate[i];
-                }
-            }
-            return result;
+        static std::string toString(const char *value) {
+            return value ? value : "";
         }
 
-        template<typename... Args>
         static std::vector<std::pair<std::string, std::string>> mapArgumentsToPlaceholders(
-            const std::string &messageTemplate, const Args &... args) {
+            const std::string &messageTemplate, const std::vector<std::string> &values) {
             std::vector<std::pair<std::string, std::string>> argumentPairs;
-            std::vector<std::string> values{toString(args)...};
-
-            std::regex placeholderRegex(R"(\{([^{}]*)\})");
-            auto placeholderBegin = std::sregex_iterator(messageTemplate.begin(), messageTemplate.end(),
-                                                         placeholderRegex);
-            auto placeholderEnd = std::sregex_iterator();
-
             size_t valueIndex = 0;
-            for (std::sregex_iterator i = placeholderBegin; i != placeholderEnd && valueIndex < values.size(); ++i) {
-                std::smatch match = *i;
-                std::string placeholder = match[1].str();
-
-                if (placeholder.empty() && match.prefix().str().back() == '{') {
-                    continue;
+            forEachPlaceholder(messageTemplate, [&](std::string placeholder) {
+                if (valueIndex < values.size()) {
+                    argumentPairs.emplace_back(std::move(placeholder), values[valueIndex++]);
                 }
-
-                argumentPairs.emplace_back(placeholder, values[valueIndex++]);
-            }
-
+            });
             return argumentPairs;
         }
     };
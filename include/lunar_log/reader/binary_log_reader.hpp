@@ -0,0 +1,180 @@
+#ifndef LUNAR_LOG_BINARY_LOG_READER_HPP
+#define LUNAR_LOG_BINARY_LOG_READER_HPP
+
+#include "../core/log_entry.hpp"
+#include "../core/log_common.hpp"
+#include "../core/binary_codec.hpp"
+#include "../formatter/binary_formatter.hpp"
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace minta {
+    // Decodes a stream written by BinaryFormatter back into LogEntry values.
+    // The buffer must outlive the reader.
+    class BinaryLogReader {
+    public:
+        BinaryLogReader(const char *data, size_t size)
+            : m_cursor(data, size), m_data(data), m_lastTimestamp(0), m_dictionaryEntry(false) {
+        }
+
+        // Returns false at the end of the stream or on malformed input; error()
+        // tells the two apart.
+        bool next(LogEntry &entry) {
+            while (!m_cursor.atEnd()) {
+                if (startsWithMagic()) {
+                    m_cursor.seek(m_cursor.offset() + BinaryLogFormat::magicSize());
+                    m_templates.clear();
+                    m_strings.clear();
+                    m_lastTimestamp = 0;
+                    continue;
+                }
+
+                uint8_t recordType;
+                m_cursor.readByte(recordType);
+                if (recordType == BinaryLogFormat::RecordTemplate) {
+                    if (!readTemplate()) return fail("truncated template record");
+                } else if (recordType == BinaryLogFormat::RecordString) {
+                    if (!readStringDefinition()) return fail("truncated string record");
+                } else if (recordType == BinaryLogFormat::RecordEntry) {
+                    return readEntry(entry);
+                } else {
+                    return fail("unknown record type");
+                }
+            }
+            return false;
+        }
+
+        const std::string &error() const {
+            return m_error;
+        }
+
+        size_t offset() const {
+            return m_cursor.offset();
+        }
+
+    private:
+        struct TemplateInfo {
+            std::string templateStr;
+            std::vector<std::string> names;
+        };
+
+        BinaryCursor m_cursor;
+        const char *m_data;
+        int64_t m_lastTimestamp;
+        std::vector<TemplateInfo> m_templates;
+        std::vector<std::string> m_strings;
+        bool m_dictionaryEntry;
+        std::vector<std::string> m_values;
+        std::string m_error;
+
+        bool startsWithMagic() const {
+            return m_cursor.remaining() >= BinaryLogFormat::magicSize() &&
+                   std::memcmp(m_data + m_cursor.offset(), BinaryLogFormat::magic(), BinaryLogFormat::magicSize()) == 0;
+        }
+
+        bool fail(const char *message) {
+            m_error = message;
+            m_cursor.seek(static_cast<size_t>(-1));
+            return false;
+        }
+
+        bool readTemplate() {
+            uint64_t id, nameCount;
+            TemplateInfo info;
+            if (!m_cursor.readVarint(id) || !m_cursor.readLengthPrefixed(info.templateStr) ||
+                !m_cursor.readVarint(nameCount) || nameCount > m_cursor.remaining()) {
+                return false;
+            }
+            info.names.resize(static_cast<size_t>(nameCount));
+            for (auto &name : info.names) {
+                if (!m_cursor.readLengthPrefixed(name)) return false;
+            }
+            if (id != m_templates.size()) {
+                return false;
+            }
+            m_templates.push_back(std::move(info));
+            return true;
+        }
+
+        bool readStringDefinition() {
+            uint64_t id;
+            std::string value;
+            if (!m_cursor.readVarint(id) || !m_cursor.readLengthPrefixed(value) || id != m_strings.size() + 1) {
+                return false;
+            }
+            m_strings.push_back(std::move(value));
+            return true;
+        }
+
+        bool readString(std::string &value) {
+            if (!m_dictionaryEntry) {
+                return m_cursor.readLengthPrefixed(value);
+            }
+            uint64_t id;
+            if (!m_cursor.readVarint(id)) {
+                return false;
+            }
+            if (id == 0) {
+                return m_cursor.readLengthPrefixed(value);
+            }
+            if (id > m_strings.size()) {
+                return false;
+            }
+            value = m_strings[static_cast<size_t>(id - 1)];
+            return true;
+        }
+
+        bool readEntry(LogEntry &entry) {
+            uint64_t templateId;
+            uint8_t level, flags;
+            int64_t delta;
+            if (!m_cursor.readVarint(templateId) || !m_cursor.readByte(level) ||
+                !m_cursor.readZigZag(delta) || !m_cursor.readByte(flags)) {
+                return fail("truncated entry record");
+            }
+            if (templateId >= m_templates.size()) return fail("unknown template id");
+            if (level > static_cast<uint8_t>(LogLevel::FATAL)) return fail("invalid level");
+
+            const TemplateInfo &info = m_templates[static_cast<size_t>(templateId)];
+            m_lastTimestamp += delta;
+            m_dictionaryEntry = (flags & BinaryLogFormat::FlagDictionary) != 0;
+
+            entry = LogEntry();
+            entry.level = static_cast<LogLevel>(level);
+            entry.timestamp = fromEpochNanos(m_lastTimestamp);
+            entry.templateStr = info.templateStr;
+            entry.line = 0;
+
+            m_values.resize(info.names.size());
+            for (size_t i = 0; i < info.names.size(); ++i) {
+                if (!readString(m_values[i])) return fail("truncated argument");
+                entry.arguments.emplace_back(info.names[i], m_values[i]);
+            }
+            entry.message = renderMessageTemplate(info.templateStr, m_values);
+
+            if (flags & BinaryLogFormat::FlagSource) {
+                uint64_t line;
+                if (!readString(entry.file) || !m_cursor.readVarint(line) || !readString(entry.function)) {
+                    return fail("truncated source location");
+                }
+                entry.line = static_cast<int>(line);
+            }
+
+            if (flags & BinaryLogFormat::FlagContext) {
+                uint64_t count;
+                if (!m_cursor.readVarint(count)) return fail("truncated context");
+                std::string key, value;
+                for (uint64_t i = 0; i < count; ++i) {
+                    if (!readString(key) || !readString(value)) {
+                        return fail("truncated context");
+                    }
+                    entry.customContext[key] = value;
+                }
+            }
+            return true;
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_BINARY_LOG_READER_HPP
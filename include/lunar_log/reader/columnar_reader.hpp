@@ -0,0 +1,218 @@
+#ifndef LUNAR_LOG_COLUMNAR_READER_HPP
+#define LUNAR_LOG_COLUMNAR_READER_HPP
+
+#include "../core/log_entry.hpp"
+#include "../core/binary_codec.hpp"
+#include "../sink/columnar_sink.hpp"
+#include <string>
+#include <vector>
+#include <cstring>
+#include <functional>
+
+namespace minta {
+    struct ColumnarRowGroupInfo {
+        size_t offset;
+        size_t size;
+        size_t rowCount;
+        int64_t minTimestamp;
+        int64_t maxTimestamp;
+        LogLevel minLevel;
+        LogLevel maxLevel;
+    };
+
+    // Reads archives written by ColumnarSink. The buffer must outlive the reader.
+    class ColumnarReader {
+    public:
+        ColumnarReader(const char *data, size_t size)
+            : m_data(data), m_size(size), m_valid(false) {
+            m_valid = size >= ColumnarLogFormat::magicSize() &&
+                      std::memcmp(data, ColumnarLogFormat::magic(), ColumnarLogFormat::magicSize()) == 0;
+            if (m_valid) {
+                indexRowGroups();
+            }
+        }
+
+        bool valid() const {
+            return m_valid;
+        }
+
+        const std::vector<ColumnarRowGroupInfo> &rowGroups() const {
+            return m_rowGroups;
+        }
+
+        bool readRowGroup(const ColumnarRowGroupInfo &info, std::vector<LogEntry> &rows) const {
+            BinaryCursor cursor(m_data + info.offset, info.size);
+            return decodeRowGroup(cursor, rows);
+        }
+
+        // Calls visit for every entry with from <= timestamp <= to (epoch ns) and
+        // level >= minLevel, decoding only row groups whose statistics overlap.
+        // Returns the number of row groups that were decoded.
+        size_t scan(int64_t from, int64_t to, LogLevel minLevel,
+                    const std::function<void(const LogEntry &)> &visit) const {
+            size_t decoded = 0;
+            std::vector<LogEntry> rows;
+            for (const auto &info : m_rowGroups) {
+                if (info.maxTimestamp < from || info.minTimestamp > to || info.maxLevel < minLevel) {
+                    continue;
+                }
+                ++decoded;
+                if (!readRowGroup(info, rows)) {
+                    break;
+                }
+                for (const auto &row : rows) {
+                    int64_t ts = toEpochNanos(row.timestamp);
+                    if (ts >= from && ts <= to && row.level >= minLevel) {
+                        visit(row);
+                    }
+                }
+            }
+            return decoded;
+        }
+
+    private:
+        const char *m_data;
+        size_t m_size;
+        bool m_valid;
+        std::vector<ColumnarRowGroupInfo> m_rowGroups;
+
+        void indexRowGroups() {
+            BinaryCursor cursor(m_data, m_size);
+            cursor.seek(ColumnarLogFormat::magicSize());
+            while (!cursor.atEnd()) {
+                uint64_t bodySize;
+                if (!cursor.readVarint(bodySize) || bodySize > cursor.remaining()) {
+                    return;
+                }
+                ColumnarRowGroupInfo info;
+                info.offset = cursor.offset();
+                info.size = static_cast<size_t>(bodySize);
+
+                BinaryCursor header(m_data + info.offset, info.size);
+                uint64_t rowCount;
+                uint8_t minLevel, maxLevel;
+                if (!header.readVarint(rowCount) || !header.readZigZag(info.minTimestamp) ||
+                    !header.readZigZag(info.maxTimestamp) || !header.readByte(minLevel) || !header.readByte(maxLevel)) {
+                    return;
+                }
+                info.rowCount = static_cast<size_t>(rowCount);
+                info.minLevel = static_cast<LogLevel>(minLevel);
+                info.maxLevel = static_cast<LogLevel>(maxLevel);
+                m_rowGroups.push_back(info);
+                cursor.seek(info.offset + info.size);
+            }
+        }
+
+        static bool readDictionary(BinaryCursor &cursor, std::vector<std::string> &dictionary) {
+            uint64_t count;
+            if (!cursor.readVarint(count) || count > cursor.remaining()) {
+                return false;
+            }
+            dictionary.resize(static_cast<size_t>(count));
+            for (auto &value : dictionary) {
+                if (!cursor.readLengthPrefixed(value)) return false;
+            }
+            return true;
+        }
+
+        template<typename Setter>
+        static bool readDictionaryColumn(BinaryCursor &cursor, std::vector<LogEntry> &rows, Setter set) {
+            std::vector<std::string> dictionary;
+            if (!readDictionary(cursor, dictionary)) {
+                return false;
+            }
+            for (auto &row : rows) {
+                uint64_t index;
+                if (!cursor.readVarint(index) || index >= dictionary.size()) return false;
+                set(row, dictionary[static_cast<size_t>(index)]);
+            }
+            return true;
+        }
+
+        static bool decodeRowGroup(BinaryCursor &cursor, std::vector<LogEntry> &rows) {
+            uint64_t rowCount;
+            int64_t minTs, maxTs;
+            uint8_t minLevel, maxLevel;
+            if (!cursor.readVarint(rowCount) || !cursor.readZigZag(minTs) || !cursor.readZigZag(maxTs) ||
+                !cursor.readByte(minLevel) || !cursor.readByte(maxLevel) || rowCount > cursor.remaining()) {
+                return false;
+            }
+
+            rows.assign(static_cast<size_t>(rowCount), LogEntry());
+            int64_t ts = 0;
+            for (auto &row : rows) {
+                int64_t delta;
+                if (!cursor.readZigZag(delta)) return false;
+                ts += delta;
+                row.timestamp = fromEpochNanos(ts);
+            }
+
+            std::string packed(ColumnarLogFormat::packedLevelBytes(rows.size()), '\0');
+            if (!cursor.readBytes(&packed[0], packed.size())) {
+                return false;
+            }
+            for (size_t i = 0; i < rows.size(); ++i) {
+                size_t bit = i * 3;
+                unsigned value = static_cast<unsigned char>(packed[bit / 8]) >> (bit % 8);
+                if (bit % 8 > 5) {
+                    value |= static_cast<unsigned>(static_cast<unsigned char>(packed[bit / 8 + 1])) << (8 - bit % 8);
+                }
+                rows[i].level = static_cast<LogLevel>(value & 0x7);
+            }
+
+            if (!readDictionaryColumn(cursor, rows, [](LogEntry &row, const std::string &v) { row.templateStr = v; })) {
+                return false;
+            }
+            for (auto &row : rows) {
+                if (!cursor.readLengthPrefixed(row.message)) return false;
+            }
+            if (!readDictionaryColumn(cursor, rows, [](LogEntry &row, const std::string &v) { row.file = v; })) {
+                return false;
+            }
+            for (auto &row : rows) {
+                uint64_t line;
+                if (!cursor.readVarint(line)) return false;
+                row.line = static_cast<int>(line);
+            }
+            if (!readDictionaryColumn(cursor, rows, [](LogEntry &row, const std::string &v) { row.function = v; })) {
+                return false;
+            }
+
+            uint64_t columnCount;
+            if (!cursor.readVarint(columnCount)) return false;
+            for (uint64_t c = 0; c < columnCount; ++c) {
+                std::string key;
+                std::vector<std::string> dictionary;
+                if (!cursor.readLengthPrefixed(key) || !readDictionary(cursor, dictionary)) return false;
+                for (auto &row : rows) {
+                    uint64_t index;
+                    if (!cursor.readVarint(index) || index > dictionary.size()) return false;
+                    if (index > 0) {
+                        row.customContext[key] = dictionary[static_cast<size_t>(index - 1)];
+                    }
+                }
+            }
+
+            if (!cursor.readVarint(columnCount)) return false;
+            for (uint64_t c = 0; c < columnCount; ++c) {
+                std::string name;
+                if (!cursor.readLengthPrefixed(name)) return false;
+                for (auto &row : rows) {
+                    uint64_t position;
+                    if (!cursor.readVarint(position) || position > columnCount) return false;
+                    if (position > 0) {
+                        size_t index = static_cast<size_t>(position - 1);
+                        if (index >= row.arguments.size()) {
+                            row.arguments.resize(index + 1);
+                        }
+                        row.arguments[index].first = name;
+                        if (!cursor.readLengthPrefixed(row.arguments[index].second)) return false;
+                    }
+                }
+            }
+            return true;
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_COLUMNAR_READER_HPP
@@ -0,0 +1,108 @@
+#ifndef LUNAR_LOG_FILE_INDEX_HPP
+#define LUNAR_LOG_FILE_INDEX_HPP
+
+#include "../sink/file_index_writer.hpp"
+#include "log_line.hpp"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace minta {
+    struct FileIndexPoint {
+        // Newest timestamp written up to and including this point's entry.
+        int64_t timestamp;
+        // No entry from this point up to the next one is older than this.
+        int64_t earliest;
+        uint64_t offset;
+    };
+
+    // Sparse timestamp index written next to a log file by FileSink.
+    class FileIndex {
+    public:
+        FileIndex(const char *data, size_t size)
+            : m_valid(false) {
+            if (size < FileIndexFormat::magicSize() ||
+                std::memcmp(data, FileIndexFormat::magic(), FileIndexFormat::magicSize()) != 0) {
+                return;
+            }
+            m_valid = true;
+            size_t count = (size - FileIndexFormat::magicSize()) / FileIndexFormat::pointSize();
+            m_points.reserve(count);
+            const char *point = data + FileIndexFormat::magicSize();
+            for (size_t i = 0; i < count; ++i, point += FileIndexFormat::pointSize()) {
+                m_points.push_back(FileIndexPoint{static_cast<int64_t>(readLittleEndian(point)),
+                                                  static_cast<int64_t>(readLittleEndian(point + 8)),
+                                                  readLittleEndian(point + 16)});
+            }
+        }
+
+        bool valid() const {
+            return m_valid;
+        }
+
+        const std::vector<FileIndexPoint> &points() const {
+            return m_points;
+        }
+
+        // Returns [begin, end) byte offsets in the log file covering every entry
+        // with from <= timestamp <= to (epoch ns). The range starts at the last
+        // index point whose entries are all older than `from` and ends after the
+        // last segment that can hold an entry up to `to`, so it may include
+        // entries outside the requested window, such as a backtrace dumped
+        // long after its entries were logged.
+        std::pair<uint64_t, uint64_t> byteRange(int64_t from, int64_t to, uint64_t fileSize) const {
+            auto byTime = [](const FileIndexPoint &point, int64_t time) { return point.timestamp < time; };
+            auto first = std::lower_bound(m_points.begin(), m_points.end(), from, byTime);
+            uint64_t begin = first == m_points.begin() ? 0 : (first - 1)->offset;
+
+            // Segment floors are not sorted once entries arrive out of order.
+            size_t last = m_points.size();
+            while (last > 0 && m_points[last - 1].earliest > to) {
+                --last;
+            }
+            uint64_t end = last == m_points.size() ? fileSize : m_points[last].offset;
+            if (end > fileSize) end = fileSize;
+            if (begin > end) begin = end;
+            return std::make_pair(begin, end);
+        }
+
+        // Calls visit(line, length) for each line in the indexed range whose
+        // timestamp lies in [from, to]. Lines without a timestamp are skipped.
+        template<typename Visitor>
+        void forEachLineInRange(const char *log, size_t logSize, int64_t from, int64_t to, Visitor visit) const {
+            std::pair<uint64_t, uint64_t> range = byteRange(from, to, logSize);
+            TimestampParser parser;
+            const char *pos = log + range.first;
+            const char *end = log + range.second;
+            while (pos < end) {
+                const char *newline = static_cast<const char *>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+                const char *lineEnd = newline ? newline : end;
+                size_t length = static_cast<size_t>(lineEnd - pos);
+
+                const char *timestamp = findTimestamp(pos, length);
+                int64_t time;
+                if (timestamp &&
+                    parser.parse(timestamp, length - static_cast<size_t>(timestamp - pos), time) &&
+                    time >= from && time <= to) {
+                    visit(pos, length);
+                }
+                pos = lineEnd + 1;
+            }
+        }
+
+    private:
+        bool m_valid;
+        std::vector<FileIndexPoint> m_points;
+
+        static uint64_t readLittleEndian(const char *data) {
+            uint64_t value = 0;
+            for (int i = 7; i >= 0; --i) {
+                value = (value << 8) | static_cast<unsigned char>(data[i]);
+            }
+            return value;
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_FILE_INDEX_HPP
@@ -0,0 +1,187 @@
+#ifndef LUNAR_LOG_FRAMED_LOG_READER_HPP
+#define LUNAR_LOG_FRAMED_LOG_READER_HPP
+
+#include "../core/binary_codec.hpp"
+#include "../core/crc32c.hpp"
+#include "../transport/framed_file_transport.hpp"
+#include <string>
+#include <vector>
+#include <cstring>
+
+namespace minta {
+    struct FramedSegmentInfo {
+        size_t offset;
+        uint64_t sequence;
+        uint32_t recordCount;
+        size_t payloadOffset;
+        size_t payloadSize;
+    };
+
+    struct FramedSequenceGap {
+        uint64_t after;
+        uint64_t next;
+    };
+
+    struct FramedRecoveryReport {
+        FramedRecoveryReport()
+            : corruptRegions(0), skippedBytes(0), tornTail(false), validLength(0) {
+        }
+
+        // Regions that failed validation and were skipped to reach the next segment.
+        size_t corruptRegions;
+        size_t skippedBytes;
+        // Sequence numbers missing between consecutive valid segments. A segment
+        // with sequence 0 starts a new writer session and is not reported.
+        std::vector<FramedSequenceGap> gaps;
+        // True when the data ends inside a segment, e.g. after a crash mid-write.
+        bool tornTail;
+        // Length of the prefix ending with the last valid segment; truncating the
+        // file to this length leaves only intact segments.
+        size_t validLength;
+    };
+
+    // Scans a buffer written by FramedFileTransport, validating every segment and
+    // resynchronising on the next magic after damaged data. The buffer must
+    // outlive the reader.
+    class FramedLogReader {
+    public:
+        FramedLogReader(const char *data, size_t size)
+            : m_data(data), m_size(size) {
+            scan();
+        }
+
+        const std::vector<FramedSegmentInfo> &segments() const {
+            return m_segments;
+        }
+
+        const FramedRecoveryReport &report() const {
+            return m_report;
+        }
+
+        bool readSegment(const FramedSegmentInfo &segment, std::vector<std::string> &records) const {
+            records.clear();
+            BinaryCursor cursor(m_data + segment.payloadOffset, segment.payloadSize);
+            std::string record;
+            while (!cursor.atEnd()) {
+                if (!cursor.readLengthPrefixed(record)) {
+                    return false;
+                }
+                records.push_back(record);
+            }
+            return records.size() == segment.recordCount;
+        }
+
+        template<typename Visitor>
+        void forEachRecord(Visitor visit) const {
+            std::vector<std::string> records;
+            for (const auto &segment : m_segments) {
+                if (readSegment(segment, records)) {
+                    for (const auto &record : records) {
+                        visit(record);
+                    }
+                }
+            }
+        }
+
+        // Splits the buffer into up to `parts` ranges that each start at a valid
+        // segment, so separate FramedLogReader instances can scan them in parallel.
+        // Returns the start offsets; each range ends where the next one begins.
+        static std::vector<size_t> splitAtSegments(const char *data, size_t size, size_t parts) {
+            std::vector<size_t> starts;
+            for (size_t part = 0; part < parts; ++part) {
+                size_t pos = findSegment(data, size, size / parts * part);
+                if (pos < size && (starts.empty() || pos > starts.back())) {
+                    starts.push_back(pos);
+                }
+            }
+            return starts;
+        }
+
+        static bool validSegmentAt(const char *data, size_t size, size_t offset, FramedSegmentInfo &segment) {
+            const size_t headerSize = FramedLogFormat::headerSize();
+            if (size - offset < headerSize ||
+                std::memcmp(data + offset, FramedLogFormat::magic(), FramedLogFormat::magicSize()) != 0) {
+                return false;
+            }
+            const char *header = data + offset;
+            size_t payloadSize = static_cast<size_t>(FramedLogFormat::readLittleEndian(header + 12, 4));
+            if (size - offset - headerSize < payloadSize) {
+                return false;
+            }
+            uint32_t expected = static_cast<uint32_t>(FramedLogFormat::readLittleEndian(header + 20, 4));
+            uint32_t crc = crc32c(header + 4, 16);
+            crc = crc32c(header + headerSize, payloadSize, crc);
+            if (crc != expected) {
+                return false;
+            }
+
+            segment.offset = offset;
+            segment.sequence = FramedLogFormat::readLittleEndian(header + 4, 8);
+            segment.recordCount = static_cast<uint32_t>(FramedLogFormat::readLittleEndian(header + 16, 4));
+            segment.payloadOffset = offset + headerSize;
+            segment.payloadSize = payloadSize;
+            return true;
+        }
+
+    private:
+        const char *m_data;
+        size_t m_size;
+        std::vector<FramedSegmentInfo> m_segments;
+        FramedRecoveryReport m_report;
+
+        static size_t findSegment(const char *data, size_t size, size_t from) {
+            FramedSegmentInfo segment;
+            for (size_t pos = findMagic(data, size, from); pos < size; pos = findMagic(data, size, pos + 1)) {
+                if (validSegmentAt(data, size, pos, segment)) {
+                    return pos;
+                }
+            }
+            return size;
+        }
+
+        static size_t findMagic(const char *data, size_t size, size_t from) {
+            const char first = FramedLogFormat::magic()[0];
+            while (from < size) {
+                const void *hit = std::memchr(data + from, first, size - from);
+                if (!hit) {
+                    return size;
+                }
+                size_t pos = static_cast<size_t>(static_cast<const char *>(hit) - data);
+                if (size - pos >= FramedLogFormat::magicSize() &&
+                    std::memcmp(data + pos, FramedLogFormat::magic(), FramedLogFormat::magicSize()) == 0) {
+                    return pos;
+                }
+                from = pos + 1;
+            }
+            return size;
+        }
+
+        void scan() {
+            size_t pos = 0;
+            FramedSegmentInfo segment;
+            while (pos < m_size) {
+                if (validSegmentAt(m_data, m_size, pos, segment)) {
+                    if (!m_segments.empty() && segment.sequence != 0 &&
+                        segment.sequence != m_segments.back().sequence + 1) {
+                        m_report.gaps.push_back(FramedSequenceGap{m_segments.back().sequence, segment.sequence});
+                    }
+                    m_segments.push_back(segment);
+                    pos = segment.payloadOffset + segment.payloadSize;
+                    m_report.validLength = pos;
+                    continue;
+                }
+
+                size_t next = findSegment(m_data, m_size, pos + 1);
+                if (next == m_size) {
+                    m_report.tornTail = true;
+                } else {
+                    ++m_report.corruptRegions;
+                }
+                m_report.skippedBytes += next - pos;
+                pos = next;
+            }
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_FRAMED_LOG_READER_HPP
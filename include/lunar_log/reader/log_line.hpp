@@ -0,0 +1,512 @@
+#ifndef LUNAR_LOG_LOG_LINE_HPP
+#define LUNAR_LOG_LOG_LINE_HPP
+
+#include "../core/log_common.hpp"
+#include "../core/log_level.hpp"
+#include "../core/log_entry.hpp"
+#include "../core/binary_codec.hpp"
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+
+namespace minta {
+    // Length of the text written by formatTimestamp(): "YYYY-MM-DD HH:MM:SS.mmm".
+    inline size_t timestampTextLength() {
+        return 23;
+    }
+
+    inline bool looksLikeTimestamp(const char *text, size_t length) {
+        static const char shape[] = "dddd-dd-dd dd:dd:dd.ddd";
+        if (length < timestampTextLength()) {
+            return false;
+        }
+        for (size_t i = 0; i < timestampTextLength(); ++i) {
+            if (shape[i] == 'd' ? (text[i] < '0' || text[i] > '9') : text[i] != shape[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline const char *findSubstring(const char *text, size_t length, const char *needle, size_t needleLength) {
+        if (needleLength == 0 || length < needleLength) {
+            return nullptr;
+        }
+        const char *end = text + length - needleLength + 1;
+        for (const char *pos = text; pos < end;) {
+            const void *hit = std::memchr(pos, needle[0], static_cast<size_t>(end - pos));
+            if (!hit) {
+                return nullptr;
+            }
+            pos = static_cast<const char *>(hit);
+            if (std::memcmp(pos, needle, needleLength) == 0) {
+                return pos;
+            }
+            ++pos;
+        }
+        return nullptr;
+    }
+
+    // Locates the timestamp in a line written by HumanReadableFormatter,
+    // JsonFormatter or XmlFormatter. Returns nullptr if there is none.
+    inline const char *findTimestamp(const char *line, size_t length) {
+        if (looksLikeTimestamp(line, length)) {
+            return line;
+        }
+        static const char jsonKey[] = "\"timestamp\":\"";
+        static const char xmlTag[] = "<timestamp>";
+        const char *found = findSubstring(line, length, jsonKey, sizeof(jsonKey) - 1);
+        size_t keyLength = sizeof(jsonKey) - 1;
+        if (!found) {
+            found = findSubstring(line, length, xmlTag, sizeof(xmlTag) - 1);
+            keyLength = sizeof(xmlTag) - 1;
+        }
+        if (!found) {
+            return nullptr;
+        }
+        const char *value = found + keyLength;
+        return looksLikeTimestamp(value, length - static_cast<size_t>(value - line)) ? value : nullptr;
+    }
+
+    // Converts formatTimestamp() text (local time) back to epoch nanoseconds.
+    // The date-and-time part is cached, since consecutive lines mostly share it.
+    class TimestampParser {
+    public:
+        TimestampParser() : m_cachedSeconds(0) {
+            std::memset(m_cachedText, 0, sizeof(m_cachedText));
+        }
+
+        // Accepts "YYYY-MM-DD HH:MM:SS" with an optional ".mmm" suffix.
+        bool parse(const char *text, size_t length, int64_t &epochNanos) {
+            static const char shape[] = "dddd-dd-dd dd:dd:dd";
+            const size_t secondsLength = sizeof(shape) - 1;
+            if (length < secondsLength) {
+                return false;
+            }
+            for (size_t i = 0; i < secondsLength; ++i) {
+                if (shape[i] == 'd' ? (text[i] < '0' || text[i] > '9') : text[i] != shape[i]) {
+                    return false;
+                }
+            }
+
+            if (std::memcmp(text, m_cachedText, secondsLength) != 0) {
+                std::tm local = std::tm();
+                local.tm_year = number(text, 4) - 1900;
+                local.tm_mon = number(text + 5, 2) - 1;
+                local.tm_mday = number(text + 8, 2);
+                local.tm_hour = number(text + 11, 2);
+                local.tm_min = number(text + 14, 2);
+                local.tm_sec = number(text + 17, 2);
+                local.tm_isdst = -1;
+                m_cachedSeconds = static_cast<int64_t>(std::mktime(&local));
+                std::memcpy(m_cachedText, text, secondsLength);
+            }
+
+            int64_t millis = 0;
+            if (length >= timestampTextLength() && text[secondsLength] == '.') {
+                for (size_t i = secondsLength + 1; i < timestampTextLength(); ++i) {
+                    if (text[i] < '0' || text[i] > '9') return false;
+                    millis = millis * 10 + (text[i] - '0');
+                }
+            }
+            epochNanos = m_cachedSeconds * 1000000000LL + millis * 1000000LL;
+            return true;
+        }
+
+    private:
+        char m_cachedText[20];
+        int64_t m_cachedSeconds;
+
+        static int number(const char *text, int digits) {
+            int value = 0;
+            for (int i = 0; i < digits; ++i) {
+                value = value * 10 + (text[i] - '0');
+            }
+            return value;
+        }
+    };
+
+    enum class LogLineFormat {
+        HumanReadable,
+        Json,
+        Xml
+    };
+
+    struct TextSpan {
+        TextSpan() : data(nullptr), size(0) {
+        }
+
+        TextSpan(const char *data, size_t size) : data(data), size(size) {
+        }
+
+        bool empty() const {
+            return size == 0;
+        }
+
+        bool equals(const char *text, size_t length) const {
+            return size == length && (length == 0 || std::memcmp(data, text, length) == 0);
+        }
+
+        const char *data;
+        size_t size;
+    };
+
+    // Fields of one line written by HumanReadableFormatter, JsonFormatter or
+    // XmlFormatter. Spans point into the line and keep the formatter's escaping.
+    struct LogLineView {
+        LogLineFormat format;
+        LogLevel level;
+        const char *timestamp;
+        TextSpan message;
+        TextSpan file;
+        int line;
+        TextSpan function;
+        TextSpan context;
+    };
+
+    inline bool parseLevelString(const char *text, size_t length, LogLevel &level) {
+        static const LogLevel levels[] = {LogLevel::TRACE, LogLevel::DEBUG, LogLevel::INFO,
+                                          LogLevel::WARN, LogLevel::ERROR, LogLevel::FATAL};
+        for (LogLevel candidate : levels) {
+            const char *name = getLevelString(candidate);
+            if (std::strlen(name) == length && std::memcmp(name, text, length) == 0) {
+                level = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    namespace detail {
+        inline bool consume(const char *&pos, const char *end, const char *literal, size_t length) {
+            if (static_cast<size_t>(end - pos) < length || std::memcmp(pos, literal, length) != 0) {
+                return false;
+            }
+            pos += length;
+            return true;
+        }
+
+        inline const char *findByte(const char *pos, const char *end, char c) {
+            return pos < end ? static_cast<const char *>(std::memchr(pos, c, static_cast<size_t>(end - pos))) : nullptr;
+        }
+
+        // Finds the closing quote of a JSON string starting at pos.
+        inline const char *findJsonStringEnd(const char *pos, const char *end) {
+            for (const char *quote = findByte(pos, end, '"'); quote; quote = findByte(quote + 1, end, '"')) {
+                size_t backslashes = 0;
+                for (const char *back = quote; back > pos && back[-1] == '\\'; --back) {
+                    ++backslashes;
+                }
+                if (backslashes % 2 == 0) {
+                    return quote;
+                }
+            }
+            return nullptr;
+        }
+
+        inline int parseInt(const char *pos, const char *end) {
+            int value = 0;
+            for (; pos < end && *pos >= '0' && *pos <= '9'; ++pos) {
+                value = value * 10 + (*pos - '0');
+            }
+            return value;
+        }
+
+        inline bool parseJsonString(const char *&pos, const char *end, const char *key, size_t keyLength, TextSpan &value) {
+            if (!consume(pos, end, key, keyLength)) {
+                return false;
+            }
+            const char *close = findJsonStringEnd(pos, end);
+            if (!close) {
+                return false;
+            }
+            value = TextSpan(pos, static_cast<size_t>(close - pos));
+            pos = close + 1;
+            return true;
+        }
+
+        inline bool parseXmlElement(const char *&pos, const char *end, const char *open, size_t openLength,
+                                    const char *close, size_t closeLength, TextSpan &value) {
+            if (!consume(pos, end, open, openLength)) {
+                return false;
+            }
+            const char *valueEnd = findByte(pos, end, '<');
+            if (!valueEnd) {
+                return false;
+            }
+            value = TextSpan(pos, static_cast<size_t>(valueEnd - pos));
+            pos = valueEnd;
+            return consume(pos, end, close, closeLength);
+        }
+
+        inline bool parseJsonLine(const char *pos, const char *end, LogLineView &view) {
+            TextSpan text;
+            if (!parseJsonString(pos, end, "{\"level\":\"", 10, text) || !parseLevelString(text.data, text.size, view.level) ||
+                !parseJsonString(pos, end, ",\"timestamp\":\"", 14, text) || !looksLikeTimestamp(text.data, text.size) ||
+                !parseJsonString(pos, end, ",\"message\":\"", 12, view.message)) {
+                return false;
+            }
+            view.format = LogLineFormat::Json;
+            view.timestamp = text.data;
+            if (parseJsonString(pos, end, ",\"file\":\"", 9, view.file)) {
+                if (!consume(pos, end, ",\"line\":", 8)) {
+                    return false;
+                }
+                view.line = parseInt(pos, end);
+                const char *comma = findByte(pos, end, ',');
+                if (!comma) {
+                    return false;
+                }
+                pos = comma;
+                if (!parseJsonString(pos, end, ",\"function\":\"", 13, view.function)) {
+                    return false;
+                }
+            }
+            if (consume(pos, end, ",\"context\":{", 12)) {
+                const char *close = pos;
+                while (close < end && *close == '"') {
+                    close = findJsonStringEnd(close + 1, end);
+                    if (!close) return false;
+                    close += 3; // ":"
+                    close = close <= end ? findJsonStringEnd(close, end) : nullptr;
+                    if (!close) return false;
+                    ++close;
+                    if (close < end && *close == ',') ++close;
+                }
+                view.context = TextSpan(pos, static_cast<size_t>(close - pos));
+            }
+            return true;
+        }
+
+        inline bool parseXmlLine(const char *pos, const char *end, LogLineView &view) {
+            TextSpan text;
+            if (!consume(pos, end, "<log_entry>", 11) ||
+                !parseXmlElement(pos, end, "<level>", 7, "</level>", 8, text) ||
+                !parseLevelString(text.data, text.size, view.level) ||
+                !parseXmlElement(pos, end, "<timestamp>", 11, "</timestamp>", 12, text) ||
+                !looksLikeTimestamp(text.data, text.size) ||
+                !parseXmlElement(pos, end, "<message>", 9, "</message>", 10, view.message)) {
+                return false;
+            }
+            view.format = LogLineFormat::Xml;
+            view.timestamp = text.data;
+            if (parseXmlElement(pos, end, "<file>", 6, "</file>", 7, view.file)) {
+                if (!parseXmlElement(pos, end, "<line>", 6, "</line>", 7, text) ||
+                    !parseXmlElement(pos, end, "<function>", 10, "</function>", 11, view.function)) {
+                    return false;
+                }
+                view.line = parseInt(text.data, text.data + text.size);
+            }
+            if (consume(pos, end, "<context>", 9)) {
+                const char *close = findSubstring(pos, static_cast<size_t>(end - pos), "</context>", 10);
+                if (!close) {
+                    return false;
+                }
+                view.context = TextSpan(pos, static_cast<size_t>(close - pos));
+            }
+            return true;
+        }
+
+        // The human-readable layout is "<timestamp> [LEVEL] message [file:line function] {k=v, ...}"
+        // with the last two parts optional, so they are recognised from the end of the line.
+        inline bool parseHumanReadableLine(const char *line, const char *end, LogLineView &view) {
+            const char *pos = line + timestampTextLength();
+            if (!consume(pos, end, " [", 2)) {
+                return false;
+            }
+            const char *close = findByte(pos, end, ']');
+            if (!close || !parseLevelString(pos, static_cast<size_t>(close - pos), view.level)) {
+                return false;
+            }
+            pos = close + 1;
+            if (pos < end && *pos == ' ') {
+                ++pos;
+            }
+            view.format = LogLineFormat::HumanReadable;
+            view.timestamp = line;
+
+            const char *messageEnd = end;
+            while (messageEnd > pos && messageEnd[-1] == ' ') {
+                --messageEnd;
+            }
+            if (messageEnd > pos && messageEnd[-1] == '}') {
+                for (const char *open = messageEnd - 1; open > pos; --open) {
+                    if (open[0] == '{' && open[-1] == ' ') {
+                        view.context = TextSpan(open + 1, static_cast<size_t>(messageEnd - 1 - (open + 1)));
+                        messageEnd = open - 1;
+                        break;
+                    }
+                }
+            }
+            if (messageEnd > pos && messageEnd[-1] == ']') {
+                for (const char *open = messageEnd - 1; open > pos; --open) {
+                    if (open[0] == '[' && open[-1] == ' ') {
+                        const char *source = open + 1;
+                        const char *sourceEnd = messageEnd - 1;
+                        const char *space = findByte(source, sourceEnd, ' ');
+                        const char *colon = nullptr;
+                        for (const char *c = space ? space : sourceEnd; c > source; --c) {
+                            if (c[-1] == ':') {
+                                colon = c - 1;
+                                break;
+                            }
+                        }
+                        if (space && colon) {
+                            view.file = TextSpan(source, static_cast<size_t>(colon - source));
+                            view.line = parseInt(colon + 1, space);
+                            view.function = TextSpan(space + 1, static_cast<size_t>(sourceEnd - space - 1));
+                            messageEnd = open - 1;
+                        }
+                        break;
+                    }
+                }
+            }
+            view.message = TextSpan(pos, static_cast<size_t>(messageEnd - pos));
+            return true;
+        }
+    } // namespace detail
+
+    // Parses a line written by one of the built-in text formatters.
+    inline bool parseLogLine(const char *line, size_t length, LogLineView &view) {
+        view = LogLineView();
+        view.line = 0;
+        const char *end = line + length;
+        if (length > 0 && end[-1] == '\r') {
+            --end;
+        }
+        if (looksLikeTimestamp(line, length)) {
+            return detail::parseHumanReadableLine(line, end, view);
+        }
+        if (length > 0 && line[0] == '{') {
+            return detail::parseJsonLine(line, end, view);
+        }
+        if (length > 0 && line[0] == '<') {
+            return detail::parseXmlLine(line, end, view);
+        }
+        return false;
+    }
+
+    // Calls visit(key, value) for each context pair of a parsed line, until it returns false.
+    template<typename Visitor>
+    void forEachContextValue(const LogLineView &view, Visitor visit) {
+        const char *pos = view.context.data;
+        const char *end = pos + view.context.size;
+        while (pos && pos < end) {
+            TextSpan key, value;
+            if (view.format == LogLineFormat::HumanReadable) {
+                const char *equals = detail::findByte(pos, end, '=');
+                if (!equals) return;
+                const char *next = findSubstring(equals, static_cast<size_t>(end - equals), ", ", 2);
+                const char *valueEnd = next ? next : end;
+                key = TextSpan(pos, static_cast<size_t>(equals - pos));
+                value = TextSpan(equals + 1, static_cast<size_t>(valueEnd - equals - 1));
+                pos = next ? next + 2 : end;
+            } else if (view.format == LogLineFormat::Json) {
+                const char *keyEnd = detail::findJsonStringEnd(pos + 1, end);
+                if (!keyEnd || end - keyEnd < 3) return;
+                const char *valueEnd = detail::findJsonStringEnd(keyEnd + 3, end);
+                if (!valueEnd) return;
+                key = TextSpan(pos + 1, static_cast<size_t>(keyEnd - pos - 1));
+                value = TextSpan(keyEnd + 3, static_cast<size_t>(valueEnd - keyEnd - 3));
+                pos = valueEnd + 1;
+                if (pos < end && *pos == ',') ++pos;
+            } else {
+                const char *keyEnd = detail::findByte(pos, end, '>');
+                if (!keyEnd || *pos != '<') return;
+                const char *valueEnd = detail::findByte(keyEnd, end, '<');
+                if (!valueEnd) return;
+                key = TextSpan(pos + 1, static_cast<size_t>(keyEnd - pos - 1));
+                value = TextSpan(keyEnd + 1, static_cast<size_t>(valueEnd - keyEnd - 1));
+                const char *closeEnd = detail::findByte(valueEnd, end, '>');
+                pos = closeEnd ? closeEnd + 1 : end;
+            }
+            if (!visit(key, value)) {
+                return;
+            }
+        }
+    }
+
+    // Appends text with the line format's escaping (JSON or XML) removed.
+    inline void appendUnescaped(LogLineFormat format, const TextSpan &text, std::string &out) {
+        const char *pos = text.data;
+        const char *end = text.data + text.size;
+        if (format == LogLineFormat::Json) {
+            while (pos < end) {
+                char c = *pos++;
+                if (c != '\\' || pos == end) {
+                    out += c;
+                    continue;
+                }
+                char escaped = *pos++;
+                switch (escaped) {
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'n': out += '\n'; break;
+                    case 'r': out += '\r'; break;
+                    case 't': out += '\t'; break;
+                    case 'u':
+                        if (end - pos >= 4) {
+                            out += static_cast<char>(std::strtol(std::string(pos, 4).c_str(), nullptr, 16));
+                            pos += 4;
+                        }
+                        break;
+                    default: out += escaped; break;
+                }
+            }
+        } else if (format == LogLineFormat::Xml) {
+            static const char *const entities[] = {"&lt;", "&gt;", "&amp;", "&apos;", "&quot;"};
+            static const char replacements[] = "<>&'\"";
+            while (pos < end) {
+                bool replaced = false;
+                if (*pos == '&') {
+                    for (size_t i = 0; i < 5; ++i) {
+                        size_t length = std::strlen(entities[i]);
+                        if (static_cast<size_t>(end - pos) >= length && std::memcmp(pos, entities[i], length) == 0) {
+                            out += replacements[i];
+                            pos += length;
+                            replaced = true;
+                            break;
+                        }
+                    }
+                }
+                if (!replaced) {
+                    out += *pos++;
+                }
+            }
+        } else {
+            out.append(pos, text.size);
+        }
+    }
+
+    // Rebuilds a LogEntry from a parsed line. Text output does not keep the
+    // template or arguments, so templateStr is left empty.
+    inline bool toLogEntry(const LogLineView &view, TimestampParser &parser, LogEntry &entry) {
+        int64_t time;
+        if (!parser.parse(view.timestamp, timestampTextLength(), time)) {
+            return false;
+        }
+        entry.level = view.level;
+        entry.timestamp = fromEpochNanos(time);
+        entry.message.clear();
+        appendUnescaped(view.format, view.message, entry.message);
+        entry.templateStr.clear();
+        entry.arguments.clear();
+        entry.file.clear();
+        appendUnescaped(view.format, view.file, entry.file);
+        entry.line = view.line;
+        entry.function.clear();
+        appendUnescaped(view.format, view.function, entry.function);
+        entry.customContext.clear();
+        forEachContextValue(view, [&](const TextSpan &key, const TextSpan &value) {
+            std::string keyText, valueText;
+            appendUnescaped(view.format, key, keyText);
+            appendUnescaped(view.format, value, valueText);
+            entry.customContext[keyText] = valueText;
+            return true;
+        });
+        return true;
+    }
+} // namespace minta
+
+#endif // LUNAR_LOG_LOG_LINE_HPP
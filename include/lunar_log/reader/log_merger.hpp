@@ -0,0 +1,198 @@
+#ifndef LUNAR_LOG_LOG_MERGER_HPP
+#define LUNAR_LOG_LOG_MERGER_HPP
+
+#include "log_line.hpp"
+#include "binary_log_reader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace minta {
+    namespace detail {
+        class MergeSource {
+        public:
+            MergeSource() : m_skipped(0) {
+            }
+
+            virtual ~MergeSource() = default;
+
+            // Reads the next entry; false at the end of the input.
+            virtual bool next(LogEntry &entry) = 0;
+
+            size_t skipped() const {
+                return m_skipped;
+            }
+
+        protected:
+            size_t m_skipped;
+        };
+
+        class TextMergeSource : public MergeSource {
+        public:
+            TextMergeSource(const char *data, size_t size) : m_pos(data), m_end(data + size) {
+            }
+
+            bool next(LogEntry &entry) override {
+                while (m_pos < m_end) {
+                    const char *newline = static_cast<const char *>(std::memchr(m_pos, '\n', static_cast<size_t>(m_end - m_pos)));
+                    const char *lineEnd = newline ? newline : m_end;
+                    const char *line = m_pos;
+                    m_pos = lineEnd + 1;
+
+                    LogLineView view;
+                    if (parseLogLine(line, static_cast<size_t>(lineEnd - line), view) && toLogEntry(view, m_parser, entry)) {
+                        return true;
+                    }
+                    if (lineEnd > line) {
+                        ++m_skipped;
+                    }
+                }
+                return false;
+            }
+
+        private:
+            const char *m_pos;
+            const char *m_end;
+            TimestampParser m_parser;
+        };
+
+        class BinaryMergeSource : public MergeSource {
+        public:
+            BinaryMergeSource(const char *data, size_t size) : m_reader(data, size) {
+            }
+
+            bool next(LogEntry &entry) override {
+                if (m_reader.next(entry)) {
+                    return true;
+                }
+                if (!m_reader.error().empty()) {
+                    ++m_skipped;
+                }
+                return false;
+            }
+
+        private:
+            BinaryLogReader m_reader;
+        };
+
+        struct WindowEntry {
+            LogEntry entry;
+            uint64_t sequence;
+        };
+    } // namespace detail
+
+    // Streams entries from several log files in timestamp order. A file written
+    // by one sink is mostly sorted, but a dumped backtrace puts older entries
+    // after newer ones, so each input is re-sorted within a window of its next
+    // reorderWindow entries. Entries displaced further than that are emitted
+    // late and counted by outOfOrder(). Inputs may be text written by the
+    // built-in formatters or BinaryFormatter output, and must outlive the merger.
+    class LogMerger {
+    public:
+        explicit LogMerger(size_t reorderWindow = 1024)
+            : m_reorderWindow(reorderWindow ? reorderWindow : 1), m_outOfOrder(0) {
+        }
+
+        void addInput(const char *data, size_t size) {
+            if (size >= BinaryLogFormat::magicSize() &&
+                std::memcmp(data, BinaryLogFormat::magic(), BinaryLogFormat::magicSize()) == 0) {
+                m_sources.push_back(make_unique<detail::BinaryMergeSource>(data, size));
+            } else {
+                m_sources.push_back(make_unique<detail::TextMergeSource>(data, size));
+            }
+        }
+
+        // Calls visit(entry, inputIndex) for every entry in timestamp order; ties
+        // keep input order. Returns the number of entries visited.
+        template<typename Visitor>
+        size_t merge(Visitor visit) {
+            std::vector<std::vector<detail::WindowEntry>> windows(m_sources.size());
+            uint64_t sequence = 0;
+            auto laterInWindow = [](const detail::WindowEntry &a, const detail::WindowEntry &b) {
+                if (a.entry.timestamp != b.entry.timestamp) {
+                    return a.entry.timestamp > b.entry.timestamp;
+                }
+                return a.sequence > b.sequence;
+            };
+            auto next = [&](size_t source, LogEntry &entry) {
+                std::vector<detail::WindowEntry> &window = windows[source];
+                while (window.size() < m_reorderWindow) {
+                    window.push_back(detail::WindowEntry{LogEntry(), sequence});
+                    if (!m_sources[source]->next(window.back().entry)) {
+                        window.pop_back();
+                        break;
+                    }
+                    ++sequence;
+                    std::push_heap(window.begin(), window.end(), laterInWindow);
+                }
+                if (window.empty()) {
+                    return false;
+                }
+                std::pop_heap(window.begin(), window.end(), laterInWindow);
+                entry = std::move(window.back().entry);
+                window.pop_back();
+                return true;
+            };
+
+            std::vector<LogEntry> pending(m_sources.size());
+            std::vector<size_t> heap;
+            auto later = [&pending](size_t a, size_t b) {
+                if (pending[a].timestamp != pending[b].timestamp) {
+                    return pending[a].timestamp > pending[b].timestamp;
+                }
+                return a > b;
+            };
+
+            for (size_t i = 0; i < m_sources.size(); ++i) {
+                if (next(i, pending[i])) {
+                    heap.push_back(i);
+                }
+            }
+            std::make_heap(heap.begin(), heap.end(), later);
+
+            size_t count = 0;
+            m_outOfOrder = 0;
+            std::chrono::system_clock::time_point last;
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                size_t source = heap.back();
+                if (count > 0 && pending[source].timestamp < last) {
+                    ++m_outOfOrder;
+                }
+                last = pending[source].timestamp;
+                visit(static_cast<const LogEntry &>(pending[source]), source);
+                ++count;
+                if (next(source, pending[source])) {
+                    std::push_heap(heap.begin(), heap.end(), later);
+                } else {
+                    heap.pop_back();
+                }
+            }
+            return count;
+        }
+
+        // Lines or records that could not be decoded, summed over all inputs.
+        size_t skipped() const {
+            size_t total = 0;
+            for (const auto &source : m_sources) {
+                total += source->skipped();
+            }
+            return total;
+        }
+
+        // Entries the last merge() emitted after a later timestamp.
+        size_t outOfOrder() const {
+            return m_outOfOrder;
+        }
+
+    private:
+        size_t m_reorderWindow;
+        size_t m_outOfOrder;
+        std::vector<std::unique_ptr<detail::MergeSource>> m_sources;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_LOG_MERGER_HPP
@@ -0,0 +1,228 @@
+#ifndef LUNAR_LOG_LOG_QUERY_HPP
+#define LUNAR_LOG_LOG_QUERY_HPP
+
+#include "log_line.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace minta {
+    // Matches rendered messages against a message template: placeholders such as
+    // {name} and '*' match any text, "{{" and "}}" match literal braces.
+    class TemplateMatcher {
+    public:
+        TemplateMatcher() : m_anchoredStart(true), m_anchoredEnd(true) {
+        }
+
+        explicit TemplateMatcher(const std::string &pattern)
+            : m_anchoredStart(true), m_anchoredEnd(true) {
+            std::string literal;
+            bool wildcard = false;
+            for (size_t i = 0; i < pattern.size(); ++i) {
+                char c = pattern[i];
+                if ((c == '{' || c == '}') && i + 1 < pattern.size() && pattern[i + 1] == c) {
+                    literal += c;
+                    ++i;
+                    continue;
+                }
+                size_t close = c == '{' ? pattern.find('}', i) : std::string::npos;
+                if (c == '*' || close != std::string::npos) {
+                    if (m_segments.empty() && literal.empty()) {
+                        m_anchoredStart = false;
+                    }
+                    if (!literal.empty() || m_segments.empty()) {
+                        m_segments.push_back(literal);
+                    }
+                    literal.clear();
+                    wildcard = true;
+                    if (c == '{') i = close;
+                    continue;
+                }
+                literal += c;
+                wildcard = false;
+            }
+            m_segments.push_back(literal);
+            m_anchoredEnd = !wildcard;
+        }
+
+        bool matches(const char *text, size_t length) const {
+            if (m_segments.size() == 1) {
+                return m_segments[0].size() == length && std::memcmp(text, m_segments[0].data(), length) == 0;
+            }
+            const char *pos = text;
+            const char *end = text + length;
+            for (size_t i = 0; i < m_segments.size(); ++i) {
+                const std::string &segment = m_segments[i];
+                if (segment.empty()) {
+                    continue;
+                }
+                bool first = i == 0;
+                bool last = i + 1 == m_segments.size();
+                if (last && m_anchoredEnd) {
+                    if (static_cast<size_t>(end - pos) < segment.size() ||
+                        std::memcmp(end - segment.size(), segment.data(), segment.size()) != 0) {
+                        return false;
+                    }
+                    return !first || static_cast<size_t>(end - pos) == segment.size();
+                }
+                if (first && m_anchoredStart) {
+                    if (static_cast<size_t>(end - pos) < segment.size() ||
+                        std::memcmp(pos, segment.data(), segment.size()) != 0) {
+                        return false;
+                    }
+                    pos += segment.size();
+                    continue;
+                }
+                const char *found = findSubstring(pos, static_cast<size_t>(end - pos), segment.data(), segment.size());
+                if (!found) {
+                    return false;
+                }
+                pos = found + segment.size();
+            }
+            return true;
+        }
+
+    private:
+        std::vector<std::string> m_segments;
+        bool m_anchoredStart;
+        bool m_anchoredEnd;
+    };
+
+    struct LogQuery {
+        LogQuery()
+            : minLevel(LogLevel::TRACE)
+            , from(std::numeric_limits<int64_t>::min())
+            , to(std::numeric_limits<int64_t>::max()) {
+        }
+
+        LogLevel minLevel;
+        // Inclusive bounds in epoch nanoseconds.
+        int64_t from;
+        int64_t to;
+        std::string messageTemplate;
+        std::string contextKey;
+        std::string contextValue;
+    };
+
+    // A LogQuery prepared for repeated evaluation against raw lines.
+    class LogLineFilter {
+    public:
+        explicit LogLineFilter(const LogQuery &query)
+            : m_query(query), m_template(query.messageTemplate) {
+        }
+
+        bool matches(const char *line, size_t length, TimestampParser &parser, std::string &scratch) const {
+            LogLineView view;
+            if (!parseLogLine(line, length, view) || view.level < m_query.minLevel) {
+                return false;
+            }
+            if (m_query.from != std::numeric_limits<int64_t>::min() ||
+                m_query.to != std::numeric_limits<int64_t>::max()) {
+                int64_t time;
+                if (!parser.parse(view.timestamp, timestampTextLength(), time) ||
+                    time < m_query.from || time > m_query.to) {
+                    return false;
+                }
+            }
+            if (!m_query.messageTemplate.empty()) {
+                const TextSpan &message = view.message;
+                bool escaped = view.format != LogLineFormat::HumanReadable &&
+                               (std::memchr(message.data, '\\', message.size) || std::memchr(message.data, '&', message.size));
+                if (escaped) {
+                    scratch.clear();
+                    appendUnescaped(view.format, message, scratch);
+                    if (!m_template.matches(scratch.data(), scratch.size())) return false;
+                } else if (!m_template.matches(message.data, message.size)) {
+                    return false;
+                }
+            }
+            if (!m_query.contextKey.empty()) {
+                bool found = false;
+                const LogQuery &query = m_query;
+                forEachContextValue(view, [&](const TextSpan &key, const TextSpan &value) {
+                    if (key.equals(query.contextKey.data(), query.contextKey.size())) {
+                        found = query.contextValue.empty() || value.equals(query.contextValue.data(), query.contextValue.size());
+                        return false;
+                    }
+                    return true;
+                });
+                if (!found) return false;
+            }
+            return true;
+        }
+
+    private:
+        LogQuery m_query;
+        TemplateMatcher m_template;
+    };
+
+    // Calls visit(line, length) in file order for every line matching the filter.
+    // The data is processed in rounds of `threads` chunks of about chunkBytes each,
+    // split at line boundaries and scanned in parallel; matches are buffered only
+    // for the current round. Returns the number of matching lines.
+    template<typename Visitor>
+    size_t scanLines(const char *data, size_t size, const LogLineFilter &filter, Visitor visit,
+                     unsigned threads = 0, size_t chunkBytes = 8 * 1024 * 1024) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        typedef std::vector<std::pair<size_t, size_t>> Matches;
+
+        auto scanChunk = [&filter, data](size_t begin, size_t end, Matches &matches) {
+            TimestampParser parser;
+            std::string scratch;
+            size_t pos = begin;
+            while (pos < end) {
+                const char *newline = static_cast<const char *>(std::memchr(data + pos, '\n', end - pos));
+                size_t lineEnd = newline ? static_cast<size_t>(newline - data) : end;
+                if (lineEnd > pos && filter.matches(data + pos, lineEnd - pos, parser, scratch)) {
+                    matches.push_back(std::make_pair(pos, lineEnd - pos));
+                }
+                pos = lineEnd + 1;
+            }
+        };
+
+        auto lineBoundaryAfter = [data, size](size_t pos) {
+            if (pos >= size) return size;
+            const char *newline = static_cast<const char *>(std::memchr(data + pos, '\n', size - pos));
+            return newline ? static_cast<size_t>(newline - data) + 1 : size;
+        };
+
+        size_t total = 0;
+        std::vector<Matches> matches(threads);
+        size_t offset = 0;
+        while (offset < size) {
+            std::vector<std::pair<size_t, size_t>> chunks;
+            for (unsigned i = 0; i < threads && offset < size; ++i) {
+                size_t end = lineBoundaryAfter(offset + chunkBytes - 1);
+                chunks.push_back(std::make_pair(offset, end));
+                offset = end;
+            }
+
+            std::vector<std::thread> workers;
+            for (size_t i = 1; i < chunks.size(); ++i) {
+                matches[i].clear();
+                workers.emplace_back(scanChunk, chunks[i].first, chunks[i].second, std::ref(matches[i]));
+            }
+            matches[0].clear();
+            scanChunk(chunks[0].first, chunks[0].second, matches[0]);
+            for (auto &worker : workers) {
+                worker.join();
+            }
+
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                for (const auto &match : matches[i]) {
+                    visit(data + match.first, match.second);
+                }
+                total += matches[i].size();
+            }
+        }
+        return total;
+    }
+} // namespace minta
+
+#endif // LUNAR_LOG_LOG_QUERY_HPP
@@ -0,0 +1,90 @@
+#ifndef LUNAR_LOG_MAPPED_FILE_HPP
+#define LUNAR_LOG_MAPPED_FILE_HPP
+
+#include <string>
+
+#if defined(_WIN32)
+#include <fstream>
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace minta {
+    // Read-only view of a whole file. Uses mmap on POSIX systems and falls back
+    // to reading the file into memory elsewhere.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string &path)
+            : m_data(nullptr), m_size(0), m_open(false) {
+#if defined(_WIN32)
+            std::ifstream file(path, std::ios::binary);
+            if (file.is_open()) {
+                std::ostringstream contents;
+                contents << file.rdbuf();
+                m_buffer = contents.str();
+                m_data = m_buffer.data();
+                m_size = m_buffer.size();
+                m_open = true;
+            }
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                return;
+            }
+            struct stat info;
+            if (::fstat(fd, &info) == 0) {
+                m_size = static_cast<size_t>(info.st_size);
+                m_open = true;
+                if (m_size > 0) {
+                    void *mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (mapping == MAP_FAILED) {
+                        m_size = 0;
+                        m_open = false;
+                    } else {
+                        m_data = static_cast<const char *>(mapping);
+                        ::posix_madvise(mapping, m_size, POSIX_MADV_SEQUENTIAL);
+                    }
+                }
+            }
+            ::close(fd);
+#endif
+        }
+
+        ~MappedFile() {
+#if !defined(_WIN32)
+            if (m_data) {
+                ::munmap(const_cast<char *>(m_data), m_size);
+            }
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        bool isOpen() const {
+            return m_open;
+        }
+
+        const char *data() const {
+            return m_data;
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+    private:
+        const char *m_data;
+        size_t m_size;
+        bool m_open;
+#if defined(_WIN32)
+        std::string m_buffer;
+#endif
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_MAPPED_FILE_HPP
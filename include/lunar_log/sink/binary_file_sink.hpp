@@ -0,0 +1,34 @@
+#ifndef LUNAR_LOG_BINARY_FILE_SINK_HPP
+#define LUNAR_LOG_BINARY_FILE_SINK_HPP
+
+#include "sink_interface.hpp"
+#include "../core/log_common.hpp"
+#include "../formatter/binary_formatter.hpp"
+#include "../transport/binary_file_transport.hpp"
+
+namespace minta {
+    class BinaryFileSink : public ISink {
+    public:
+        BinaryFileSink(const std::string &filename) {
+            setFormatter(make_unique<BinaryFormatter>());
+            setTransport(make_unique<BinaryFileTransport>(filename));
+        }
+
+        BinaryFileSink(const std::string &filename, const BinaryDictionaryOptions &dictionaryOptions) {
+            setFormatter(make_unique<BinaryFormatter>(dictionaryOptions));
+            setTransport(make_unique<BinaryFileTransport>(filename));
+        }
+
+        void write(const LogEntry &entry) override {
+            if (m_formatter && m_transport) {
+                m_transport->write(m_formatter->format(entry));
+            }
+        }
+
+        bool acceptsFormattedOutput() const override {
+            return true;
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_BINARY_FILE_SINK_HPP
@@ -0,0 +1,250 @@
+#ifndef LUNAR_LOG_COLUMNAR_SINK_HPP
+#define LUNAR_LOG_COLUMNAR_SINK_HPP
+
+#include "sink_interface.hpp"
+#include "../core/binary_codec.hpp"
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+namespace minta {
+    // Layout of a columnar archive:
+    //
+    //   magic, then any number of row groups, each framed as
+    //   varint bodySize | body
+    //
+    //   body: rowCount, minTimestamp, maxTimestamp, minLevel, maxLevel, then the
+    //   columns in this order:
+    //     timestamps  first value absolute, then zigzag deltas (ns)
+    //     levels      3 bits per row, packed little-endian
+    //     templates   dictionary + per-row index
+    //     messages    length-prefixed strings
+    //     files       dictionary + per-row index
+    //     lines       varints
+    //     functions   dictionary + per-row index
+    //     context     column count, then per column: key, dictionary,
+    //                 per-row index + 1 (0 when the row has no such key)
+    //     properties  column count, then per column: name, then per row the
+    //                 argument's position + 1 followed by its length-prefixed
+    //                 value, or 0 when absent. A name repeated within one
+    //                 entry gets one column per occurrence.
+    //
+    // The statistics come first so readers can skip a row group by size.
+    struct ColumnarLogFormat {
+        static const char *magic() {
+            return "LLCOL\x02";
+        }
+
+        static size_t magicSize() {
+            return 6;
+        }
+
+        static size_t packedLevelBytes(size_t rows) {
+            return (rows * 3 + 7) / 8;
+        }
+    };
+
+    // Buffers entries and writes them as columnar row groups. A row group is
+    // written when it reaches rowGroupSize entries, on flush() and on destruction.
+    class ColumnarSink : public ISink {
+    public:
+        explicit ColumnarSink(const std::string &filename, size_t rowGroupSize = 4096)
+            : m_rowGroupSize(rowGroupSize ? rowGroupSize : 1) {
+            m_file.open(filename, std::ios::app | std::ios::binary);
+            m_file.seekp(0, std::ios::end);
+            if (m_file.tellp() == std::streampos(0)) {
+                m_file.write(ColumnarLogFormat::magic(), static_cast<std::streamsize>(ColumnarLogFormat::magicSize()));
+            }
+            m_rows.reserve(m_rowGroupSize);
+        }
+
+        ~ColumnarSink() override {
+            flush();
+        }
+
+        void write(const LogEntry &entry) override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_rows.push_back(entry);
+            if (m_rows.size() >= m_rowGroupSize) {
+                writeRowGroup();
+            }
+        }
+
+        void flush() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            writeRowGroup();
+        }
+
+    private:
+        class Dictionary {
+        public:
+            uint64_t indexOf(const std::string &value) {
+                auto it = m_ids.find(value);
+                if (it != m_ids.end()) {
+                    return it->second;
+                }
+                uint64_t id = m_values.size();
+                m_ids.emplace(value, id);
+                m_values.push_back(value);
+                return id;
+            }
+
+            void appendTo(std::string &out) const {
+                appendVarint(out, m_values.size());
+                for (const auto &value : m_values) {
+                    appendLengthPrefixed(out, value);
+                }
+            }
+
+        private:
+            std::unordered_map<std::string, uint64_t> m_ids;
+            std::vector<std::string> m_values;
+        };
+
+        size_t m_rowGroupSize;
+        std::mutex m_mutex;
+        std::ofstream m_file;
+        std::vector<LogEntry> m_rows;
+        std::string m_body;
+        std::string m_frame;
+        std::string m_scratch;
+
+        // Called with m_mutex held.
+        void writeRowGroup() {
+            if (m_rows.empty()) {
+                return;
+            }
+            m_body.clear();
+            encodeRowGroup();
+            m_frame.clear();
+            appendVarint(m_frame, m_body.size());
+            m_file.write(m_frame.data(), static_cast<std::streamsize>(m_frame.size()));
+            m_file.write(m_body.data(), static_cast<std::streamsize>(m_body.size()));
+            m_file.flush();
+            m_rows.clear();
+        }
+
+        void encodeRowGroup() {
+            int64_t minTs = toEpochNanos(m_rows.front().timestamp);
+            int64_t maxTs = minTs;
+            LogLevel minLevel = m_rows.front().level;
+            LogLevel maxLevel = minLevel;
+            for (const auto &row : m_rows) {
+                int64_t ts = toEpochNanos(row.timestamp);
+                if (ts < minTs) minTs = ts;
+                if (ts > maxTs) maxTs = ts;
+                if (row.level < minLevel) minLevel = row.level;
+                if (row.level > maxLevel) maxLevel = row.level;
+            }
+
+            appendVarint(m_body, m_rows.size());
+            appendZigZag(m_body, minTs);
+            appendZigZag(m_body, maxTs);
+            m_body += static_cast<char>(minLevel);
+            m_body += static_cast<char>(maxLevel);
+
+            int64_t previous = 0;
+            for (const auto &row : m_rows) {
+                int64_t ts = toEpochNanos(row.timestamp);
+                appendZigZag(m_body, ts - previous);
+                previous = ts;
+            }
+
+            size_t levelStart = m_body.size();
+            m_body.append(ColumnarLogFormat::packedLevelBytes(m_rows.size()), '\0');
+            for (size_t i = 0; i < m_rows.size(); ++i) {
+                unsigned level = static_cast<unsigned>(m_rows[i].level) & 0x7;
+                size_t bit = i * 3;
+                m_body[levelStart + bit / 8] = static_cast<char>(m_body[levelStart + bit / 8] | (level << (bit % 8)));
+                if (bit % 8 > 5) {
+                    m_body[levelStart + bit / 8 + 1] =
+                        static_cast<char>(m_body[levelStart + bit / 8 + 1] | (level >> (8 - bit % 8)));
+                }
+            }
+
+            encodeDictionaryColumn([](const LogEntry &row) -> const std::string & { return row.templateStr; });
+            for (const auto &row : m_rows) {
+                appendLengthPrefixed(m_body, row.message);
+            }
+            encodeDictionaryColumn([](const LogEntry &row) -> const std::string & { return row.file; });
+            for (const auto &row : m_rows) {
+                appendVarint(m_body, static_cast<uint64_t>(row.line));
+            }
+            encodeDictionaryColumn([](const LogEntry &row) -> const std::string & { return row.function; });
+
+            encodeContextColumns();
+            encodePropertyColumns();
+        }
+
+        template<typename Getter>
+        void encodeDictionaryColumn(Getter get) {
+            Dictionary dictionary;
+            m_scratch.clear();
+            for (const auto &row : m_rows) {
+                appendVarint(m_scratch, dictionary.indexOf(get(row)));
+            }
+            dictionary.appendTo(m_body);
+            m_body += m_scratch;
+        }
+
+        void encodeContextColumns() {
+            std::map<std::string, Dictionary> columns;
+            for (const auto &row : m_rows) {
+                for (const auto &ctx : row.customContext) {
+                    columns[ctx.first].indexOf(ctx.second);
+                }
+            }
+
+            appendVarint(m_body, columns.size());
+            for (auto &column : columns) {
+                appendLengthPrefixed(m_body, column.first);
+                column.second.appendTo(m_body);
+                for (const auto &row : m_rows) {
+                    auto it = row.customContext.find(column.first);
+                    appendVarint(m_body, it == row.customContext.end() ? 0 : column.second.indexOf(it->second) + 1);
+                }
+            }
+        }
+
+        void encodePropertyColumns() {
+            // Keyed by name and occurrence within the entry, so "{x} then {x}" keeps both values.
+            std::vector<std::pair<std::string, size_t>> columns;
+            std::map<std::pair<std::string, size_t>, size_t> positions;
+            std::unordered_map<std::string, size_t> occurrences;
+            for (const auto &row : m_rows) {
+                occurrences.clear();
+                for (const auto &argument : row.arguments) {
+                    std::pair<std::string, size_t> key(argument.first, occurrences[argument.first]++);
+                    if (positions.emplace(key, columns.size()).second) {
+                        columns.push_back(key);
+                    }
+                }
+            }
+
+            appendVarint(m_body, columns.size());
+            for (const auto &column : columns) {
+                appendLengthPrefixed(m_body, column.first);
+                for (const auto &row : m_rows) {
+                    size_t seen = 0;
+                    size_t position = 0;
+                    for (; position < row.arguments.size(); ++position) {
+                        if (row.arguments[position].first == column.first && seen++ == column.second) {
+                            break;
+                        }
+                    }
+                    if (position < row.arguments.size()) {
+                        appendVarint(m_body, position + 1);
+                        appendLengthPrefixed(m_body, row.arguments[position].second);
+                    } else {
+                        appendVarint(m_body, 0);
+                    }
+                }
+            }
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_COLUMNAR_SINK_HPP
@@ -18,6 +18,10 @@ namespace minta {
                 m_transport->write(m_formatter->format(entry));
             }
         }
+
+        bool acceptsFormattedOutput() const override {
+            return true;
+        }
     };
 } // namespace minta
 
@@ -0,0 +1,99 @@
+#ifndef LUNAR_LOG_FILE_INDEX_WRITER_HPP
+#define LUNAR_LOG_FILE_INDEX_WRITER_HPP
+
+#include "../core/log_entry.hpp"
+#include "../core/binary_codec.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <string>
+
+namespace minta {
+    // Sidecar index layout: magic, then fixed-size points of
+    //   latest epoch ns (int64 LE) | earliest epoch ns (int64 LE) | byte offset (uint64 LE)
+    // `latest` is the newest timestamp written up to and including the point's
+    // entry, so it never decreases and can be binary-searched in place.
+    // `earliest` is a floor for the entries from the point up to the next one.
+    // Entries can arrive out of order (a dumped backtrace keeps its original
+    // timestamps), so the writer starts a new point whenever an entry falls
+    // below the current floor.
+    struct FileIndexFormat {
+        static const char *magic() {
+            return "LLIDX\x02\0\0";
+        }
+
+        static size_t magicSize() {
+            return 8;
+        }
+
+        static size_t pointSize() {
+            return 24;
+        }
+    };
+
+    struct FileIndexOptions {
+        FileIndexOptions(size_t everyEntries = 1000,
+                         std::chrono::milliseconds everyInterval = std::chrono::milliseconds(1000))
+            : everyEntries(everyEntries), everyInterval(everyInterval) {
+        }
+
+        // An index point is recorded when either limit is reached since the last one.
+        size_t everyEntries;
+        std::chrono::milliseconds everyInterval;
+    };
+
+    class FileIndexWriter {
+    public:
+        FileIndexWriter(const std::string &indexFilename, const FileIndexOptions &options)
+            : m_options(options), m_entriesSincePoint(0), m_hasPoint(false), m_lastPointTime(0),
+              m_latest(std::numeric_limits<int64_t>::min()), m_earliest(0) {
+            m_file.open(indexFilename, std::ios::app | std::ios::binary);
+            m_file.seekp(0, std::ios::end);
+            if (m_file.tellp() == std::streampos(0)) {
+                m_file.write(FileIndexFormat::magic(), static_cast<std::streamsize>(FileIndexFormat::magicSize()));
+            }
+        }
+
+        // Counts the entry and reports whether it should get an index point.
+        bool advance(const LogEntry &entry) {
+            int64_t timestamp = toEpochNanos(entry.timestamp);
+            m_latest = std::max(m_latest, timestamp);
+            ++m_entriesSincePoint;
+            if (!m_hasPoint || m_entriesSincePoint >= m_options.everyEntries) {
+                return true;
+            }
+            int64_t interval = std::chrono::duration_cast<std::chrono::nanoseconds>(m_options.everyInterval).count();
+            return timestamp < m_earliest || timestamp - m_lastPointTime >= interval;
+        }
+
+        void addPoint(const LogEntry &entry, uint64_t offset) {
+            int64_t timestamp = toEpochNanos(entry.timestamp);
+            m_latest = std::max(m_latest, timestamp);
+            m_earliest = timestamp;
+            char point[24];
+            for (int i = 0; i < 8; ++i) {
+                point[i] = static_cast<char>((static_cast<uint64_t>(m_latest) >> (i * 8)) & 0xff);
+                point[8 + i] = static_cast<char>((static_cast<uint64_t>(m_earliest) >> (i * 8)) & 0xff);
+                point[16 + i] = static_cast<char>((offset >> (i * 8)) & 0xff);
+            }
+            m_file.write(point, sizeof(point));
+            m_file.flush();
+
+            m_hasPoint = true;
+            m_lastPointTime = m_latest;
+            m_entriesSincePoint = 0;
+        }
+
+    private:
+        FileIndexOptions m_options;
+        std::ofstream m_file;
+        size_t m_entriesSincePoint;
+        bool m_hasPoint;
+        int64_t m_lastPointTime;
+        int64_t m_latest;
+        int64_t m_earliest;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_FILE_INDEX_WRITER_HPP
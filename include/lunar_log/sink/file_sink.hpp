@@ -2,6 +2,7 @@
 #define LUNAR_LOG_FILE_SINK_HPP
 
 #include "sink_interface.hpp"
+#include "file_index_writer.hpp"
 #include "../formatter/human_readable_formatter.hpp"
 #include "../transport/file_transport.hpp"
 
@@ -13,11 +14,37 @@ namespace minta {
             setTransport(make_unique<FileTransport>(filename));
         }
 
+        // Also maintains a sparse timestamp index in filename + ".idx"; see FileIndex.
+        FileSink(const std::string &filename, const FileIndexOptions &indexOptions)
+            : FileSink(filename) {
+            m_index = make_unique<FileIndexWriter>(filename + ".idx", indexOptions);
+        }
+
         void write(const LogEntry &entry) override {
             if (m_formatter && m_transport) {
-                m_transport->write(m_formatter->format(entry));
+                writeFormatted(entry, m_formatter->format(entry));
             }
         }
+
+        bool acceptsFormattedOutput() const override {
+            return true;
+        }
+
+        void writeFormatted(const LogEntry &entry, const std::string &formattedEntry) override {
+            if (!m_transport) {
+                return;
+            }
+            if (m_index && m_index->advance(entry)) {
+                FileTransport *fileTransport = dynamic_cast<FileTransport *>(m_transport.get());
+                if (fileTransport) {
+                    m_index->addPoint(entry, static_cast<uint64_t>(fileTransport->position()));
+                }
+            }
+            m_transport->write(formattedEntry);
+        }
+
+    private:
+        std::unique_ptr<FileIndexWriter> m_index;
     };
 } // namespace minta
 
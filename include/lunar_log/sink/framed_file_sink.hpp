@@ -0,0 +1,37 @@
+#ifndef LUNAR_LOG_FRAMED_FILE_SINK_HPP
+#define LUNAR_LOG_FRAMED_FILE_SINK_HPP
+
+#include "sink_interface.hpp"
+#include "../formatter/human_readable_formatter.hpp"
+#include "../transport/framed_file_transport.hpp"
+
+namespace minta {
+    // Seals every record into its own segment by default, so nothing waits in
+    // memory; with a larger segmentBytes, call flush() to seal the open segment.
+    class FramedFileSink : public ISink {
+    public:
+        FramedFileSink(const std::string &filename, size_t segmentBytes = 0) {
+            setFormatter(make_unique<HumanReadableFormatter>());
+            setTransport(make_unique<FramedFileTransport>(filename, segmentBytes));
+        }
+
+        void write(const LogEntry &entry) override {
+            if (m_formatter && m_transport) {
+                m_transport->write(m_formatter->format(entry));
+            }
+        }
+
+        bool acceptsFormattedOutput() const override {
+            return true;
+        }
+
+        void flush() {
+            FramedFileTransport *transport = dynamic_cast<FramedFileTransport *>(m_transport.get());
+            if (transport) {
+                transport->flush();
+            }
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_FRAMED_FILE_SINK_HPP
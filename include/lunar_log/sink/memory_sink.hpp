@@ -0,0 +1,98 @@
+#ifndef LUNAR_LOG_MEMORY_SINK_HPP
+#define LUNAR_LOG_MEMORY_SINK_HPP
+
+#include "sink_interface.hpp"
+#include "../formatter/human_readable_formatter.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace minta {
+    // Keeps formatted records in a fixed-size ring. The logger's worker thread
+    // is the only producer and a single reader may take records concurrently,
+    // without locks. Records arriving while the ring is full are dropped and
+    // counted. Slots keep their string capacity, so once warmed up, storing a
+    // record does not allocate.
+    class MemorySink : public ISink {
+    public:
+        explicit MemorySink(size_t capacity = 4096)
+            : m_slots(capacity > 0 ? capacity : 1), m_head(0), m_tail(0), m_dropped(0) {
+            setFormatter(make_unique<HumanReadableFormatter>());
+        }
+
+        void write(const LogEntry &entry) override {
+            if (m_formatter) {
+                writeFormatted(entry, m_formatter->format(entry));
+            }
+        }
+
+        bool acceptsFormattedOutput() const override {
+            return true;
+        }
+
+        void writeFormatted(const LogEntry &, const std::string &formattedEntry) override {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) >= m_slots.size()) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            m_slots[tail % m_slots.size()] = formattedEntry;
+            m_tail.store(tail + 1, std::memory_order_release);
+        }
+
+        // Records stored so far, including ones already taken.
+        size_t written() const {
+            return m_tail.load(std::memory_order_acquire);
+        }
+
+        size_t dropped() const {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+        // Waits until at least `count` records have been stored.
+        bool waitFor(size_t count, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) const {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            for (int spins = 0; written() < count; ++spins) {
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    return false;
+                }
+                if (spins < 64) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            }
+            return true;
+        }
+
+        // Takes the oldest record; false when the ring is empty.
+        bool pop(std::string &record) {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            record.swap(m_slots[head % m_slots.size()]);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::vector<std::string> drain() {
+            std::vector<std::string> records;
+            std::string record;
+            while (pop(record)) {
+                records.push_back(record);
+            }
+            return records;
+        }
+
+    private:
+        std::vector<std::string> m_slots;
+        std::atomic<size_t> m_head;
+        std::atomic<size_t> m_tail;
+        std::atomic<size_t> m_dropped;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_MEMORY_SINK_HPP
@@ -0,0 +1,39 @@
+#ifndef LUNAR_LOG_NULL_SINK_HPP
+#define LUNAR_LOG_NULL_SINK_HPP
+
+#include "sink_interface.hpp"
+#include "../formatter/human_readable_formatter.hpp"
+#include "../transport/null_transport.hpp"
+
+namespace minta {
+    // Formats entries and discards the output, so only the front-end and
+    // formatting cost remain.
+    class NullSink : public ISink {
+    public:
+        NullSink() {
+            setFormatter(make_unique<HumanReadableFormatter>());
+            auto transport = make_unique<NullTransport>();
+            m_nullTransport = transport.get();
+            setTransport(std::move(transport));
+        }
+
+        void write(const LogEntry &entry) override {
+            if (m_formatter && m_transport) {
+                m_transport->write(m_formatter->format(entry));
+            }
+        }
+
+        bool acceptsFormattedOutput() const override {
+            return true;
+        }
+
+        const NullTransport &transport() const {
+            return *m_nullTransport;
+        }
+
+    private:
+        NullTransport *m_nullTransport;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_NULL_SINK_HPP
@@ -13,7 +13,19 @@ namespace minta {
 
         virtual void write(const LogEntry &entry) = 0;
 
-        void setFormatter(std::unique_ptr<IFormatter> formatter) {
+        // Sinks that only pass the formatter's output on to their transport can
+        // opt in here, letting LogManager format once per formatter instead of once per sink.
+        virtual bool acceptsFormattedOutput() const {
+            return false;
+        }
+
+        virtual void writeFormatted(const LogEntry &, const std::string &formattedEntry) {
+            if (m_transport) {
+                m_transport->write(formattedEntry);
+            }
+        }
+
+        void setFormatter(std::shared_ptr<IFormatter> formatter) {
             m_formatter = std::move(formatter);
         }
 
@@ -21,8 +33,12 @@ namespace minta {
             m_transport = std::move(transport);
         }
 
+        const IFormatter *getFormatter() const {
+            return m_formatter.get();
+        }
+
     protected:
-        std::unique_ptr<IFormatter> m_formatter;
+        std::shared_ptr<IFormatter> m_formatter;
         std::unique_ptr<ITransport> m_transport;
     };
 } // namespace minta
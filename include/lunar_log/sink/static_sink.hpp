@@ -0,0 +1,38 @@
+#ifndef LUNAR_LOG_STATIC_SINK_HPP
+#define LUNAR_LOG_STATIC_SINK_HPP
+
+#include "sink_interface.hpp"
+#include <utility>
+
+namespace minta {
+    // Sink whose formatter and transport are fixed at compile time. Both are held
+    // by value and called non-virtually, so the whole pipeline can be inlined.
+    // The formatter writes straight into the transport's append buffer.
+    template<typename Formatter, typename Transport>
+    class StaticSink : public ISink {
+    public:
+        template<typename... Args>
+        explicit StaticSink(Args &&... transportArgs)
+            : m_staticTransport(std::forward<Args>(transportArgs)...) {
+        }
+
+        void write(const LogEntry &entry) override {
+            m_staticFormatter.Formatter::formatTo(entry, m_staticTransport.Transport::buffer());
+            m_staticTransport.Transport::commit();
+        }
+
+        Formatter &formatter() {
+            return m_staticFormatter;
+        }
+
+        Transport &transport() {
+            return m_staticTransport;
+        }
+
+    private:
+        Formatter m_staticFormatter;
+        Transport m_staticTransport;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_STATIC_SINK_HPP
@@ -0,0 +1,30 @@
+#ifndef LUNAR_LOG_BINARY_FILE_TRANSPORT_HPP
+#define LUNAR_LOG_BINARY_FILE_TRANSPORT_HPP
+
+#include "transport_interface.hpp"
+#include <fstream>
+#include <mutex>
+
+namespace minta {
+    // Appends formatted entries verbatim, without a line terminator, for
+    // formatters that produce self-delimiting binary records.
+    class BinaryFileTransport : public ITransport {
+    public:
+        BinaryFileTransport(const std::string &filename) : m_filename(filename) {
+            m_file.open(filename, std::ios::app | std::ios::binary);
+        }
+
+        void write(const std::string &formattedEntry) override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_file.write(formattedEntry.data(), static_cast<std::streamsize>(formattedEntry.size()));
+            m_file.flush();
+        }
+
+    private:
+        std::string m_filename;
+        std::ofstream m_file;
+        std::mutex m_mutex;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_BINARY_FILE_TRANSPORT_HPP
@@ -0,0 +1,86 @@
+#ifndef LUNAR_LOG_FAULT_INJECTING_TRANSPORT_HPP
+#define LUNAR_LOG_FAULT_INJECTING_TRANSPORT_HPP
+
+#include "transport_interface.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace minta {
+    struct FaultOptions {
+        FaultOptions()
+            : latency(0), stallEvery(0), stallDuration(0), partialEvery(0), partialFraction(0.5), failEvery(0) {
+        }
+
+        // Added to every write.
+        std::chrono::microseconds latency;
+        // Every stallEvery-th write blocks for stallDuration.
+        uint64_t stallEvery;
+        std::chrono::milliseconds stallDuration;
+        // Every partialEvery-th write passes on only partialFraction of the entry.
+        uint64_t partialEvery;
+        double partialFraction;
+        // Every failEvery-th write throws std::runtime_error instead of writing.
+        uint64_t failEvery;
+    };
+
+    // Wraps another transport and degrades it in configurable ways, to
+    // reproduce slow or failing destinations in tests and benchmarks.
+    class FaultInjectingTransport : public ITransport {
+    public:
+        FaultInjectingTransport(std::unique_ptr<ITransport> inner, const FaultOptions &options)
+            : m_inner(std::move(inner)), m_options(options), m_writes(0), m_stalls(0), m_partialWrites(0), m_failures(0) {
+        }
+
+        void write(const std::string &formattedEntry) override {
+            uint64_t write = m_writes.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (m_options.latency.count() > 0) {
+                std::this_thread::sleep_for(m_options.latency);
+            }
+            if (m_options.stallEvery != 0 && write % m_options.stallEvery == 0) {
+                m_stalls.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::sleep_for(m_options.stallDuration);
+            }
+            if (m_options.failEvery != 0 && write % m_options.failEvery == 0) {
+                m_failures.fetch_add(1, std::memory_order_relaxed);
+                throw std::runtime_error("FaultInjectingTransport: injected write failure");
+            }
+            if (m_options.partialEvery != 0 && write % m_options.partialEvery == 0) {
+                m_partialWrites.fetch_add(1, std::memory_order_relaxed);
+                size_t length = static_cast<size_t>(static_cast<double>(formattedEntry.size()) * m_options.partialFraction);
+                m_inner->write(formattedEntry.substr(0, length));
+                return;
+            }
+            m_inner->write(formattedEntry);
+        }
+
+        uint64_t writes() const {
+            return m_writes.load(std::memory_order_relaxed);
+        }
+
+        uint64_t stalls() const {
+            return m_stalls.load(std::memory_order_relaxed);
+        }
+
+        uint64_t partialWrites() const {
+            return m_partialWrites.load(std::memory_order_relaxed);
+        }
+
+        uint64_t failures() const {
+            return m_failures.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::unique_ptr<ITransport> m_inner;
+        FaultOptions m_options;
+        std::atomic<uint64_t> m_writes;
+        std::atomic<uint64_t> m_stalls;
+        std::atomic<uint64_t> m_partialWrites;
+        std::atomic<uint64_t> m_failures;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_FAULT_INJECTING_TRANSPORT_HPP
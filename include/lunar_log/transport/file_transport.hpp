@@ -10,6 +10,7 @@ namespace minta {
     public:
         FileTransport(const std::string &filename) : m_filename(filename) {
             m_file.open(filename, std::ios::app);
+            m_file.seekp(0, std::ios::end);
         }
 
         void write(const std::string &formattedEntry) override {
@@ -18,10 +19,30 @@ namespace minta {
             m_file.flush();
         }
 
+        std::string &buffer() override {
+            m_pending.clear();
+            return m_pending;
+        }
+
+        // Writes the buffered entry and its newline in one call with a single flush.
+        void commit() override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending += '\n';
+            m_file.write(m_pending.data(), static_cast<std::streamsize>(m_pending.size()));
+            m_file.flush();
+        }
+
+        // Byte offset at which the next entry will start.
+        std::streamoff position() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return static_cast<std::streamoff>(m_file.tellp());
+        }
+
     private:
         std::string m_filename;
         std::ofstream m_file;
         std::mutex m_mutex;
+        std::string m_pending;
     };
 } // namespace minta
 
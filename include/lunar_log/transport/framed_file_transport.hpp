@@ -0,0 +1,112 @@
+#ifndef LUNAR_LOG_FRAMED_FILE_TRANSPORT_HPP
+#define LUNAR_LOG_FRAMED_FILE_TRANSPORT_HPP
+
+#include "transport_interface.hpp"
+#include "../core/binary_codec.hpp"
+#include "../core/crc32c.hpp"
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace minta {
+    // On-disk framing used by FramedFileTransport and FramedLogReader.
+    //
+    // The file is a sequence of segments:
+    //   magic (4) | sequence (8) | payload size (4) | record count (4) | crc32c (4) | payload
+    // Integers are little-endian. The checksum covers the sequence, size and count
+    // fields followed by the payload. The payload holds the records, each a varint
+    // length followed by the formatted entry. Sequence numbers start at 0 for every
+    // transport instance and increase by one per segment.
+    struct FramedLogFormat {
+        static const char *magic() {
+            return "LLSG";
+        }
+
+        static size_t magicSize() {
+            return 4;
+        }
+
+        static size_t headerSize() {
+            return 24;
+        }
+
+        static void appendLittleEndian(std::string &out, uint64_t value, int bytes) {
+            for (int i = 0; i < bytes; ++i) {
+                out += static_cast<char>((value >> (i * 8)) & 0xff);
+            }
+        }
+
+        static uint64_t readLittleEndian(const char *data, int bytes) {
+            uint64_t value = 0;
+            for (int i = bytes - 1; i >= 0; --i) {
+                value = (value << 8) | static_cast<unsigned char>(data[i]);
+            }
+            return value;
+        }
+    };
+
+    // Writes formatted entries into checksummed, sequence-numbered segments so a
+    // file cut short by a crash can be recovered up to the last complete segment.
+    // Records are buffered until the segment reaches segmentBytes, flush() is
+    // called or the transport is destroyed; segmentBytes = 0 seals every record.
+    class FramedFileTransport : public ITransport {
+    public:
+        explicit FramedFileTransport(const std::string &filename, size_t segmentBytes = 4096)
+            : m_filename(filename), m_segmentBytes(segmentBytes), m_sequence(0), m_recordCount(0) {
+            m_file.open(filename, std::ios::app | std::ios::binary);
+        }
+
+        ~FramedFileTransport() override {
+            flush();
+        }
+
+        void write(const std::string &formattedEntry) override {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            appendVarint(m_payload, formattedEntry.size());
+            m_payload += formattedEntry;
+            ++m_recordCount;
+            if (m_payload.size() >= m_segmentBytes) {
+                sealSegment();
+            }
+        }
+
+        void flush() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            sealSegment();
+        }
+
+    private:
+        std::string m_filename;
+        size_t m_segmentBytes;
+        uint64_t m_sequence;
+        uint32_t m_recordCount;
+        std::string m_payload;
+        std::string m_header;
+        std::ofstream m_file;
+        std::mutex m_mutex;
+
+        void sealSegment() {
+            if (m_recordCount == 0) {
+                return;
+            }
+
+            m_header.clear();
+            m_header.append(FramedLogFormat::magic(), FramedLogFormat::magicSize());
+            FramedLogFormat::appendLittleEndian(m_header, m_sequence++, 8);
+            FramedLogFormat::appendLittleEndian(m_header, m_payload.size(), 4);
+            FramedLogFormat::appendLittleEndian(m_header, m_recordCount, 4);
+            uint32_t crc = crc32c(m_header.data() + 4, 16);
+            crc = crc32c(m_payload.data(), m_payload.size(), crc);
+            FramedLogFormat::appendLittleEndian(m_header, crc, 4);
+
+            m_file.write(m_header.data(), static_cast<std::streamsize>(m_header.size()));
+            m_file.write(m_payload.data(), static_cast<std::streamsize>(m_payload.size()));
+            m_file.flush();
+
+            m_payload.clear();
+            m_recordCount = 0;
+        }
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_FRAMED_FILE_TRANSPORT_HPP
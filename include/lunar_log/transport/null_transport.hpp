@@ -0,0 +1,34 @@
+#ifndef LUNAR_LOG_NULL_TRANSPORT_HPP
+#define LUNAR_LOG_NULL_TRANSPORT_HPP
+
+#include "transport_interface.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace minta {
+    // Discards entries and only counts them, for benchmarks and tests.
+    class NullTransport : public ITransport {
+    public:
+        NullTransport() : m_writes(0), m_bytes(0) {
+        }
+
+        void write(const std::string &formattedEntry) override {
+            m_writes.fetch_add(1, std::memory_order_relaxed);
+            m_bytes.fetch_add(formattedEntry.size(), std::memory_order_relaxed);
+        }
+
+        uint64_t writes() const {
+            return m_writes.load(std::memory_order_relaxed);
+        }
+
+        uint64_t bytesWritten() const {
+            return m_bytes.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint64_t> m_writes;
+        std::atomic<uint64_t> m_bytes;
+    };
+} // namespace minta
+
+#endif // LUNAR_LOG_NULL_TRANSPORT_HPP
@@ -9,6 +9,22 @@ namespace minta {
     public:
         virtual ~ITransport() = default;
         virtual void write(const std::string& formattedEntry) = 0;
+
+        // Append-buffer API: format an entry straight into buffer(), then call
+        // commit() to write it. The default hands the buffer to write();
+        // transports with their own output buffer override both. A caller must
+        // not interleave buffer()/commit() pairs from several threads.
+        virtual std::string &buffer() {
+            m_appendBuffer.clear();
+            return m_appendBuffer;
+        }
+
+        virtual void commit() {
+            write(m_appendBuffer);
+        }
+
+    private:
+        std::string m_appendBuffer;
     };
 
 } // namespace minta
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/allocation_counter.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+    // Records the worker thread's allocation count each time an entry arrives.
+    class AllocationProbeSink : public minta::ISink {
+    public:
+        AllocationProbeSink(std::atomic<uint64_t> &writes, std::atomic<uint64_t> &workerAllocations)
+            : m_writes(writes), m_workerAllocations(workerAllocations) {
+        }
+
+        void write(const minta::LogEntry &entry) override {
+            writeFormatted(entry, std::string());
+        }
+
+        bool acceptsFormattedOutput() const override {
+            return true;
+        }
+
+        void writeFormatted(const minta::LogEntry &, const std::string &) override {
+            m_workerAllocations = AllocationCounter::threadAllocations();
+            ++m_writes;
+        }
+
+    private:
+        std::atomic<uint64_t> &m_writes;
+        std::atomic<uint64_t> &m_workerAllocations;
+    };
+
+    struct AllocationsPerCall {
+        double caller;
+        double worker;
+    };
+}
+
+class AllocationTest : public ::testing::Test {
+protected:
+    static const int Warmup = 200;
+    static const int Calls = 1000;
+
+    // Average allocations per call on the calling thread and on the worker
+    // thread, measured after a warm-up so queue and buffer growth settle.
+    template<typename FormatterType, typename Setup, typename Call>
+    static AllocationsPerCall measure(Setup setup, Call call, bool written = true) {
+        std::atomic<uint64_t> writes(0);
+        std::atomic<uint64_t> workerAllocations(0);
+        minta::LunarLog logger(minta::LogLevel::INFO, false);
+        logger.setRateLimit(0);
+        logger.addSink<AllocationProbeSink, FormatterType>(writes, workerAllocations);
+        setup(logger);
+
+        for (int i = 0; i < Warmup; ++i) call(logger, i);
+        waitForWrites(writes, written ? Warmup : 0);
+        uint64_t workerStart = workerAllocations;
+
+        AllocationScope caller;
+        for (int i = 0; i < Calls; ++i) call(logger, i);
+        uint64_t callerAllocations = caller.allocations();
+        waitForWrites(writes, written ? Warmup + Calls : 0);
+
+        return AllocationsPerCall{static_cast<double>(callerAllocations) / Calls,
+                                  static_cast<double>(workerAllocations - workerStart) / Calls};
+    }
+
+    template<typename Call>
+    static AllocationsPerCall measure(Call call) {
+        return measure<minta::HumanReadableFormatter>([](minta::LunarLog &) {}, call);
+    }
+
+    static void waitForWrites(const std::atomic<uint64_t> &writes, uint64_t expected) {
+        for (int i = 0; i < 5000 && writes < expected; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ASSERT_EQ(writes, expected);
+    }
+
+    static void noSetup(minta::LunarLog &) {
+    }
+};
+
+TEST_F(AllocationTest, CountsAllocationsPerThread) {
+    // Explicit operator new calls, unlike new-expressions, cannot be elided.
+    AllocationScope scope;
+    void *value = ::operator new(sizeof(int));
+    uint64_t ownAllocations = scope.allocations();
+    ::operator delete(value);
+    EXPECT_EQ(ownAllocations, 1u);
+
+    uint64_t total = AllocationCounter::totalAllocations();
+    uint64_t otherThreadAllocations = 0;
+    std::thread([&] {
+        AllocationScope otherScope;
+        void *other = ::operator new(sizeof(int));
+        otherThreadAllocations = otherScope.allocations();
+        ::operator delete(other);
+    }).join();
+    EXPECT_EQ(otherThreadAllocations, 1u);
+    EXPECT_GE(AllocationCounter::totalAllocations(), total + 1);
+}
+
+TEST_F(AllocationTest, BelowMinLevelDoesNotAllocate) {
+    // A literal longer than the small-string buffer would allocate while being
+    // converted to the std::string parameter, before the level check.
+    const std::string messageTemplate = "Processed item {index}";
+    AllocationsPerCall perCall = measure<minta::HumanReadableFormatter>(noSetup, [&](minta::LunarLog &logger, int i) {
+        logger.debug(messageTemplate, i);
+    }, false);
+    EXPECT_EQ(perCall.caller, 0.0);
+    EXPECT_EQ(perCall.worker, 0.0);
+}
+
+TEST_F(AllocationTest, CallerAllocationsByArgumentType) {
+    std::string longValue(40, 'x');
+    EXPECT_LE(measure([](minta::LunarLog &logger, int) { logger.info("Service started"); }).caller, 1.0);
+    EXPECT_LE(measure([](minta::LunarLog &logger, int i) { logger.info("Processed item {index}", i); }).caller, 7.0);
+    EXPECT_LE(measure([](minta::LunarLog &logger, int i) { logger.info("Took {seconds}", i * 0.5); }).caller, 5.0);
+    EXPECT_LE(measure([](minta::LunarLog &logger, int) { logger.info("User {name}", "alice"); }).caller, 5.0);
+    EXPECT_LE(measure([&](minta::LunarLog &logger, int) { logger.info("User {name}", longValue); }).caller, 8.0);
+    EXPECT_LE(measure([](minta::LunarLog &logger, int i) {
+        logger.info("User {name} paid {amount} for order {order}", "alice", 12.5, i);
+    }).caller, 12.0);
+}
+
+TEST_F(AllocationTest, CallerAllocationsWithContext) {
+    auto call = [](minta::LunarLog &logger, int i) {
+        logger.logWithContext(minta::LogLevel::INFO, __FILE__, __LINE__, __func__, "Processed item {index}", i);
+    };
+    EXPECT_LE(measure<minta::HumanReadableFormatter>([](minta::LunarLog &logger) {
+        logger.setContext("tenant", "acme");
+        logger.setContext("session", "abc123");
+    }, call).caller, 10.0);
+    EXPECT_LE(measure<minta::HumanReadableFormatter>([](minta::LunarLog &logger) {
+        logger.setCaptureContext(true);
+    }, call).caller, 9.0);
+}
+
+TEST_F(AllocationTest, WorkerAllocationsByFormatter) {
+    auto call = [](minta::LunarLog &logger, int i) { logger.info("Processed item {index}", i); };
+    EXPECT_LE(measure<minta::HumanReadableFormatter>(noSetup, call).worker, 6.0);
+    EXPECT_LE(measure<minta::JsonFormatter>(noSetup, call).worker, 6.0);
+    EXPECT_LE(measure<minta::XmlFormatter>(noSetup, call).worker, 8.0);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+
+class BacktraceTest : public ::testing::Test {
+};
+
+TEST_F(BacktraceTest, TriggerWritesRecentEntriesAheadOfIt) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger, nullptr, minta::LogLevel::WARN);
+    logger.setBacktrace(4);
+
+    for (int i = 0; i < 6; ++i) {
+        logger.debug("Step {index}", i);
+    }
+    logger.info("Almost done");
+    logger.warn("Passes the sink level");
+    ASSERT_TRUE(memory->waitFor(1));
+    EXPECT_EQ(memory->drain().size(), 1u);
+
+    logger.error("Failed with code {code}", 7);
+    ASSERT_TRUE(memory->waitFor(5));
+    std::vector<std::string> records = memory->drain();
+    ASSERT_EQ(records.size(), 5u);
+    EXPECT_NE(records[0].find("[DEBUG] Step 3"), std::string::npos);
+    EXPECT_NE(records[2].find("[DEBUG] Step 5"), std::string::npos);
+    EXPECT_NE(records[3].find("[INFO] Almost done"), std::string::npos);
+    EXPECT_NE(records[4].find("[ERROR] Failed with code 7"), std::string::npos);
+
+    logger.error("Second failure");
+    ASSERT_TRUE(memory->waitFor(7));
+    records = memory->drain();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_NE(records[0].find("Second failure"), std::string::npos);
+}
+
+TEST_F(BacktraceTest, KeepsArgumentsAndHonoursLoggerLevel) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    auto sink = minta::make_unique<minta::MemorySink>(256);
+    sink->setFormatter(std::make_shared<minta::JsonFormatter>());
+    minta::MemorySink *memory = sink.get();
+    minta::SinkId id = logger.addCustomSink(std::move(sink));
+    logger.setSinkMinLevel(id, minta::LogLevel::ERROR);
+    // Backtrace entries keep their arguments, so sink filters still see them.
+    logger.setSinkFilter(id, "arg.name == alice || level >= ERROR");
+    logger.setBacktrace(8, minta::LogLevel::FATAL);
+
+    logger.debug("Below the logger level");
+    logger.info("User {name} opened {count} files", "alice", 3);
+    logger.error("Not a trigger");
+    ASSERT_TRUE(memory->waitFor(1));
+    EXPECT_EQ(memory->drain().size(), 1u);
+
+    logger.fatal("Crashed");
+    ASSERT_TRUE(memory->waitFor(3));
+    std::vector<std::string> records = memory->drain();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_NE(records[0].find(R"("level":"INFO")"), std::string::npos);
+    EXPECT_NE(records[0].find(R"("message":"User alice opened 3 files")"), std::string::npos);
+    EXPECT_NE(records[1].find("Crashed"), std::string::npos);
+}
+
+TEST_F(BacktraceTest, DumpOnDemandAndDisable) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger, nullptr, minta::LogLevel::ERROR);
+    logger.setBacktrace(16);
+
+    logger.trace("first");
+    logger.debug("second");
+    logger.dumpBacktrace();
+    ASSERT_TRUE(memory->waitFor(2));
+    EXPECT_EQ(memory->drain().size(), 2u);
+
+    logger.debug("captured then discarded");
+    logger.setBacktrace(0);
+    logger.debug("not captured");
+    logger.error("only this");
+    ASSERT_TRUE(memory->waitFor(3));
+    std::vector<std::string> records = memory->drain();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_NE(records[0].find("only this"), std::string::npos);
+}
+
+TEST_F(BacktraceTest, TriggerBelowEverySinkLevelStillDumps) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger, nullptr, minta::LogLevel::ERROR);
+    logger.setBacktrace(8, minta::LogLevel::WARN);
+
+    logger.debug("Before the warning");
+    logger.warn("Disk almost full");
+    ASSERT_TRUE(memory->waitFor(2));
+    std::vector<std::string> records = memory->drain();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_NE(records[0].find("[DEBUG] Before the warning"), std::string::npos);
+    EXPECT_NE(records[1].find("[WARN] Disk almost full"), std::string::npos);
+}
+
+TEST_F(BacktraceTest, KeepsContextForSinkFilters) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    auto sink = minta::make_unique<minta::MemorySink>(256);
+    sink->setFormatter(std::make_shared<minta::JsonFormatter>());
+    minta::MemorySink *memory = sink.get();
+    minta::SinkId id = logger.addCustomSink(std::move(sink));
+    logger.setSinkMinLevel(id, minta::LogLevel::ERROR);
+    logger.setSinkFilter(id, "ctx.tenant == acme");
+    logger.setBacktrace(8);
+
+    logger.setContext("tenant", "acme");
+    logger.debug("Loaded account");
+    logger.setContext("tenant", "globex");
+    logger.debug("Other tenant");
+    logger.setContext("tenant", "acme");
+    logger.error("Payment failed");
+    ASSERT_TRUE(memory->waitFor(2));
+    std::vector<std::string> records = memory->drain();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_NE(records[0].find("Loaded account"), std::string::npos);
+    EXPECT_NE(records[0].find(R"("tenant":"acme")"), std::string::npos);
+    EXPECT_NE(records[1].find("Payment failed"), std::string::npos);
+}
+
+TEST_F(BacktraceTest, RingOverwritesOldestRecords) {
+    minta::BacktraceBuffer buffer;
+    EXPECT_TRUE(buffer.drain().empty());
+    buffer.setCapacity(3);
+    for (int i = 0; i < 5; ++i) {
+        std::vector<std::string> values{std::to_string(i)};
+        std::map<std::string, std::string> context{{"index", std::to_string(i)}};
+        buffer.push(minta::LogLevel::DEBUG, "", "", 0, "", "Value {v}", values, context);
+    }
+    std::vector<minta::BacktraceRecord> records = buffer.drain();
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].values[0], "2");
+    EXPECT_EQ(records[2].values[0], "4");
+    EXPECT_EQ(records[2].customContext.at("index"), "4");
+    EXPECT_TRUE(buffer.drain().empty());
+}
@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+
+class BinaryFormatTest : public ::testing::Test {
+protected:
+    void SetUp() override { TestUtils::cleanupLogFiles(); }
+    void TearDown() override { TestUtils::cleanupLogFiles(); }
+
+    static minta::LogEntry makeEntry(const std::string &user, int offsetMs) {
+        minta::LogEntry entry;
+        entry.level = minta::LogLevel::INFO;
+        entry.templateStr = "User {username} logged in from {ip}";
+        entry.arguments = {{"username", user}, {"ip", "10.0.0.1"}};
+        entry.message = "User " + user + " logged in from 10.0.0.1";
+        entry.timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000)) +
+                          std::chrono::milliseconds(offsetMs);
+        entry.line = 0;
+        return entry;
+    }
+};
+
+TEST_F(BinaryFormatTest, TemplateIsWrittenOnce) {
+    minta::BinaryFormatter formatter;
+    std::string first = formatter.format(makeEntry("alice", 0));
+    std::string second = formatter.format(makeEntry("bob", 5));
+
+    EXPECT_NE(first.find("User {username} logged in from {ip}"), std::string::npos);
+    EXPECT_EQ(second.find("User {username}"), std::string::npos);
+    EXPECT_LT(second.size(), first.size());
+}
+
+TEST_F(BinaryFormatTest, RoundTripsEntries) {
+    minta::BinaryFormatter formatter;
+    minta::LogEntry withContext = makeEntry("bob", -3);
+    withContext.level = minta::LogLevel::ERROR;
+    withContext.file = "main.cpp";
+    withContext.line = 17;
+    withContext.function = "handle";
+    withContext.customContext = {{"session_id", "abc123"}};
+
+    std::string data = formatter.format(makeEntry("alice", 0));
+    data += formatter.format(withContext);
+
+    minta::BinaryLogReader reader(data.data(), data.size());
+    minta::LogEntry decoded;
+
+    ASSERT_TRUE(reader.next(decoded));
+    EXPECT_EQ(decoded.message, "User alice logged in from 10.0.0.1");
+    EXPECT_EQ(decoded.level, minta::LogLevel::INFO);
+    EXPECT_EQ(decoded.timestamp, makeEntry("alice", 0).timestamp);
+    ASSERT_EQ(decoded.arguments.size(), 2u);
+    EXPECT_EQ(decoded.arguments[0].first, "username");
+    EXPECT_EQ(decoded.arguments[0].second, "alice");
+
+    ASSERT_TRUE(reader.next(decoded));
+    EXPECT_EQ(decoded.message, "User bob logged in from 10.0.0.1");
+    EXPECT_EQ(decoded.level, minta::LogLevel::ERROR);
+    EXPECT_EQ(decoded.timestamp, withContext.timestamp);
+    EXPECT_EQ(decoded.file, "main.cpp");
+    EXPECT_EQ(decoded.line, 17);
+    EXPECT_EQ(decoded.function, "handle");
+    EXPECT_EQ(decoded.customContext.at("session_id"), "abc123");
+
+    EXPECT_FALSE(reader.next(decoded));
+    EXPECT_TRUE(reader.error().empty());
+}
+
+TEST_F(BinaryFormatTest, AppendedSessionsDecodeIndependently) {
+    minta::BinaryFormatter firstRun;
+    minta::BinaryFormatter secondRun;
+    std::string data = firstRun.format(makeEntry("alice", 0));
+    data += secondRun.format(makeEntry("bob", 10));
+
+    minta::BinaryLogReader reader(data.data(), data.size());
+    minta::LogEntry decoded;
+    ASSERT_TRUE(reader.next(decoded));
+    ASSERT_TRUE(reader.next(decoded));
+    EXPECT_EQ(decoded.message, "User bob logged in from 10.0.0.1");
+    EXPECT_EQ(decoded.timestamp, makeEntry("bob", 10).timestamp);
+}
+
+TEST_F(BinaryFormatTest, ReportsTruncatedInput) {
+    minta::BinaryFormatter formatter;
+    std::string data = formatter.format(makeEntry("alice", 0));
+    data.resize(data.size() - 3);
+
+    minta::BinaryLogReader reader(data.data(), data.size());
+    minta::LogEntry decoded;
+    EXPECT_FALSE(reader.next(decoded));
+    EXPECT_FALSE(reader.error().empty());
+}
+
+TEST_F(BinaryFormatTest, BinaryFileSinkThroughLogger) {
+    {
+        minta::LunarLog logger(minta::LogLevel::INFO);
+        logger.addSink<minta::BinaryFileSink>("binary_log.bin");
+        logger.info("Order {id} shipped", 42);
+        logger.warn("Order {id} delayed", 43);
+    }
+
+    std::string data = TestUtils::readLogFile("binary_log.bin");
+    minta::BinaryLogReader reader(data.data(), data.size());
+    minta::LogEntry decoded;
+    ASSERT_TRUE(reader.next(decoded));
+    EXPECT_EQ(decoded.message, "Order 42 shipped");
+    ASSERT_TRUE(reader.next(decoded));
+    EXPECT_EQ(decoded.message, "Order 43 delayed");
+    EXPECT_EQ(decoded.level, minta::LogLevel::WARN);
+}
+
+TEST_F(BinaryFormatTest, DictionaryWritesRepeatedValuesOnce) {
+    minta::BinaryFormatter formatter{minta::BinaryDictionaryOptions()};
+    minta::LogEntry entry = makeEntry("alice", 0);
+    entry.customContext = {{"session_id", "abc123"}, {"host", "web1"}};
+
+    std::string first = formatter.format(entry);
+    std::string second = formatter.format(entry);
+
+    EXPECT_NE(first.find("abc123"), std::string::npos);
+    EXPECT_EQ(second.find("abc123"), std::string::npos);
+    EXPECT_EQ(second.find("alice"), std::string::npos);
+
+    std::string data = first + second;
+    minta::BinaryLogReader reader(data.data(), data.size());
+    minta::LogEntry decoded;
+    ASSERT_TRUE(reader.next(decoded));
+    ASSERT_TRUE(reader.next(decoded));
+    EXPECT_EQ(decoded.message, "User alice logged in from 10.0.0.1");
+    EXPECT_EQ(decoded.customContext, entry.customContext);
+    EXPECT_FALSE(reader.next(decoded));
+    EXPECT_TRUE(reader.error().empty());
+}
+
+TEST_F(BinaryFormatTest, DictionaryKeepsLongValuesInline) {
+    minta::BinaryFormatter formatter{minta::BinaryDictionaryOptions(4096, 8)};
+    std::string longUser(32, 'x');
+
+    std::string data = formatter.format(makeEntry(longUser, 0));
+    std::string second = formatter.format(makeEntry(longUser, 1));
+    EXPECT_NE(second.find(longUser), std::string::npos);
+    data += second;
+
+    minta::BinaryLogReader reader(data.data(), data.size());
+    minta::LogEntry decoded;
+    ASSERT_TRUE(reader.next(decoded));
+    ASSERT_TRUE(reader.next(decoded));
+    EXPECT_EQ(decoded.arguments[0].second, longUser);
+}
+
+TEST_F(BinaryFormatTest, DictionarySegmentsDecodeIndependently) {
+    minta::BinaryFormatter formatter{minta::BinaryDictionaryOptions(4096, 256, 2)};
+    std::string data;
+    for (int i = 0; i < 5; ++i) {
+        data += formatter.format(makeEntry("alice", i));
+    }
+
+    std::vector<size_t> segments;
+    for (size_t pos = data.find("LLBIN"); pos != std::string::npos; pos = data.find("LLBIN", pos + 1)) {
+        segments.push_back(pos);
+    }
+    ASSERT_EQ(segments.size(), 3u);
+
+    minta::BinaryLogReader reader(data.data() + segments[1], data.size() - segments[1]);
+    minta::LogEntry decoded;
+    int count = 0;
+    while (reader.next(decoded)) {
+        EXPECT_EQ(decoded.message, "User alice logged in from 10.0.0.1");
+        EXPECT_EQ(decoded.timestamp, makeEntry("alice", 2 + count).timestamp);
+        ++count;
+    }
+    EXPECT_EQ(count, 3);
+    EXPECT_TRUE(reader.error().empty());
+}
+
+TEST_F(BinaryFormatTest, DictionaryResetsWhenFull) {
+    minta::BinaryFormatter formatter{minta::BinaryDictionaryOptions(6)};
+    std::string data;
+    for (int i = 0; i < 4; ++i) {
+        data += formatter.format(makeEntry("user" + std::to_string(i), i));
+    }
+
+    minta::BinaryLogReader reader(data.data(), data.size());
+    minta::LogEntry decoded;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(reader.next(decoded));
+        EXPECT_EQ(decoded.arguments[0].second, "user" + std::to_string(i));
+    }
+    EXPECT_NE(data.find("LLBIN", 1), std::string::npos);
+}
+
+TEST_F(BinaryFormatTest, DictionaryFileSinkThroughLogger) {
+    {
+        minta::LunarLog logger(minta::LogLevel::INFO);
+        logger.addSink<minta::BinaryFileSink>("binary_log.bin", minta::BinaryDictionaryOptions());
+        logger.setContext("host", "web1");
+        logger.info("Order {id} shipped", 42);
+        logger.info("Order {id} shipped", 42);
+    }
+
+    std::string data = TestUtils::readLogFile("binary_log.bin");
+    minta::BinaryLogReader reader(data.data(), data.size());
+    minta::LogEntry decoded;
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_TRUE(reader.next(decoded));
+        EXPECT_EQ(decoded.message, "Order 42 shipped");
+        EXPECT_EQ(decoded.customContext.at("host"), "web1");
+    }
+}
+
+TEST_F(BinaryFormatTest, SinksAtDifferentLevelsEachDecode) {
+    {
+        minta::LunarLog logger(minta::LogLevel::INFO);
+        logger.addSink<minta::BinaryFileSink>("binary_log.bin", minta::BinaryDictionaryOptions());
+        minta::SinkId errors = logger.addSink<minta::BinaryFileSink>("binary_log2.bin", minta::BinaryDictionaryOptions());
+        logger.setSinkMinLevel(errors, minta::LogLevel::ERROR);
+        logger.setContext("host", "web1");
+        logger.info("Order {id} shipped", 1);
+        logger.error("Order {id} failed", 2);
+        logger.info("Order {id} shipped", 3);
+        logger.error("Order {id} failed", 4);
+    }
+
+    std::vector<std::string> expected[] = {
+        {"Order 1 shipped", "Order 2 failed", "Order 3 shipped", "Order 4 failed"},
+        {"Order 2 failed", "Order 4 failed"},
+    };
+    const char *files[] = {"binary_log.bin", "binary_log2.bin"};
+    for (int f = 0; f < 2; ++f) {
+        std::string data = TestUtils::readLogFile(files[f]);
+        minta::BinaryLogReader reader(data.data(), data.size());
+        minta::LogEntry decoded;
+        std::vector<std::string> messages;
+        while (reader.next(decoded)) {
+            messages.push_back(decoded.message);
+            EXPECT_EQ(decoded.customContext.at("host"), "web1");
+        }
+        EXPECT_TRUE(reader.error().empty()) << files[f];
+        EXPECT_EQ(messages, expected[f]);
+    }
+}
+
+TEST_F(BinaryFormatTest, StatefulFormatterCannotBeShared) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    auto formatter = std::make_shared<minta::BinaryFormatter>();
+    EXPECT_FALSE(formatter->isStateless());
+    logger.addSinkWithFormatter<minta::BinaryFileSink>(formatter, "binary_log.bin");
+    EXPECT_THROW(logger.addSinkWithFormatter<minta::BinaryFileSink>(formatter, "binary_log2.bin"),
+                 std::invalid_argument);
+}
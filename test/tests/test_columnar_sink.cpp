@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+
+class ColumnarSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override { TestUtils::cleanupLogFiles(); }
+    void TearDown() override { TestUtils::cleanupLogFiles(); }
+
+    static minta::LogEntry makeEntry(int index) {
+        minta::LogEntry entry;
+        entry.level = static_cast<minta::LogLevel>(index % 6);
+        entry.templateStr = index % 2 ? "Order {id} shipped" : "Order {id} delayed by {minutes}";
+        entry.arguments = {{"id", std::to_string(index)}};
+        if (index % 2 == 0) {
+            entry.arguments.emplace_back("minutes", std::to_string(index * 3));
+        }
+        entry.message = "message " + std::to_string(index);
+        entry.timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000)) +
+                          std::chrono::milliseconds(index * 10);
+        entry.line = index % 3 ? 0 : index;
+        if (entry.line) {
+            entry.file = "orders.cpp";
+            entry.function = "ship";
+        }
+        if (index % 4 == 0) {
+            entry.customContext["host"] = index % 8 ? "web1" : "web2";
+        }
+        return entry;
+    }
+};
+
+TEST_F(ColumnarSinkTest, RoundTripsRowGroups) {
+    {
+        minta::ColumnarSink sink("columnar_log.bin", 8);
+        for (int i = 0; i < 20; ++i) {
+            sink.write(makeEntry(i));
+        }
+    }
+
+    std::string data = TestUtils::readLogFile("columnar_log.bin");
+    minta::ColumnarReader reader(data.data(), data.size());
+    ASSERT_TRUE(reader.valid());
+    ASSERT_EQ(reader.rowGroups().size(), 3u);
+    EXPECT_EQ(reader.rowGroups()[0].rowCount, 8u);
+    EXPECT_EQ(reader.rowGroups()[2].rowCount, 4u);
+
+    std::vector<minta::LogEntry> rows;
+    int index = 0;
+    for (const auto &group : reader.rowGroups()) {
+        ASSERT_TRUE(reader.readRowGroup(group, rows));
+        for (const auto &row : rows) {
+            minta::LogEntry expected = makeEntry(index++);
+            EXPECT_EQ(row.level, expected.level);
+            EXPECT_EQ(row.timestamp, expected.timestamp);
+            EXPECT_EQ(row.templateStr, expected.templateStr);
+            EXPECT_EQ(row.message, expected.message);
+            EXPECT_EQ(row.file, expected.file);
+            EXPECT_EQ(row.line, expected.line);
+            EXPECT_EQ(row.function, expected.function);
+            EXPECT_EQ(row.arguments, expected.arguments);
+            EXPECT_EQ(row.customContext, expected.customContext);
+        }
+    }
+    EXPECT_EQ(index, 20);
+}
+
+TEST_F(ColumnarSinkTest, ScanSkipsRowGroupsOutsideRange) {
+    {
+        minta::ColumnarSink sink("columnar_log.bin", 10);
+        for (int i = 0; i < 50; ++i) {
+            sink.write(makeEntry(i));
+        }
+    }
+
+    std::string data = TestUtils::readLogFile("columnar_log.bin");
+    minta::ColumnarReader reader(data.data(), data.size());
+    ASSERT_EQ(reader.rowGroups().size(), 5u);
+
+    int64_t from = minta::toEpochNanos(makeEntry(22).timestamp);
+    int64_t to = minta::toEpochNanos(makeEntry(27).timestamp);
+    std::vector<std::string> messages;
+    size_t decoded = reader.scan(from, to, minta::LogLevel::WARN, [&](const minta::LogEntry &entry) {
+        messages.push_back(entry.message);
+    });
+
+    EXPECT_EQ(decoded, 1u);
+    EXPECT_EQ(messages, (std::vector<std::string>{"message 22", "message 23", "message 27"}));
+}
+
+TEST_F(ColumnarSinkTest, FlushesOnLoggerShutdown) {
+    {
+        minta::LunarLog logger(minta::LogLevel::INFO);
+        logger.addSink<minta::ColumnarSink>("columnar_log.bin");
+        logger.info("User {username} logged in", "alice");
+    }
+
+    std::string data = TestUtils::readLogFile("columnar_log.bin");
+    minta::ColumnarReader reader(data.data(), data.size());
+    ASSERT_EQ(reader.rowGroups().size(), 1u);
+    std::vector<minta::LogEntry> rows;
+    ASSERT_TRUE(reader.readRowGroup(reader.rowGroups()[0], rows));
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_EQ(rows[0].message, "User alice logged in");
+    EXPECT_EQ(rows[0].arguments[0].second, "alice");
+}
+
+TEST_F(ColumnarSinkTest, FlushIsSafeWhileWriting) {
+    {
+        minta::ColumnarSink sink("columnar_log.bin", 64);
+        std::thread writer([&sink]() {
+            for (int i = 0; i < 2000; ++i) {
+                sink.write(makeEntry(i));
+            }
+        });
+        for (int i = 0; i < 200; ++i) {
+            sink.flush();
+        }
+        writer.join();
+    }
+
+    std::string data = TestUtils::readLogFile("columnar_log.bin");
+    minta::ColumnarReader reader(data.data(), data.size());
+    size_t total = 0;
+    std::vector<minta::LogEntry> rows;
+    for (const auto &group : reader.rowGroups()) {
+        ASSERT_TRUE(reader.readRowGroup(group, rows));
+        total += rows.size();
+    }
+    EXPECT_EQ(total, 2000u);
+}
+
+TEST_F(ColumnarSinkTest, RoundTripsRepeatedAndReorderedArguments) {
+    std::vector<std::vector<std::pair<std::string, std::string>>> arguments = {
+        {{"x", "1"}, {"x", "2"}},
+        {{"b", "late"}, {"a", "early"}},
+        {{"a", "first"}, {"b", "second"}, {"a", "third"}},
+        {},
+    };
+    {
+        minta::ColumnarSink sink("columnar_log.bin");
+        for (size_t i = 0; i < arguments.size(); ++i) {
+            minta::LogEntry entry = makeEntry(static_cast<int>(i));
+            entry.arguments = arguments[i];
+            sink.write(entry);
+        }
+    }
+
+    std::string data = TestUtils::readLogFile("columnar_log.bin");
+    minta::ColumnarReader reader(data.data(), data.size());
+    ASSERT_EQ(reader.rowGroups().size(), 1u);
+    std::vector<minta::LogEntry> rows;
+    ASSERT_TRUE(reader.readRowGroup(reader.rowGroups()[0], rows));
+    ASSERT_EQ(rows.size(), arguments.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        EXPECT_EQ(rows[i].arguments, arguments[i]);
+    }
+}
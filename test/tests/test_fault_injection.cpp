@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include <vector>
+
+namespace {
+    class RecordingTransport : public minta::ITransport {
+    public:
+        explicit RecordingTransport(std::vector<std::string> &records) : m_records(records) {
+        }
+
+        void write(const std::string &formattedEntry) override {
+            m_records.push_back(formattedEntry);
+        }
+
+    private:
+        std::vector<std::string> &m_records;
+    };
+
+    class FaultySink : public minta::ISink {
+    public:
+        explicit FaultySink(const minta::FaultOptions &options) {
+            setFormatter(minta::make_unique<minta::HumanReadableFormatter>());
+            setTransport(minta::make_unique<minta::FaultInjectingTransport>(
+                minta::make_unique<minta::NullTransport>(), options));
+        }
+
+        void write(const minta::LogEntry &entry) override {
+            m_transport->write(m_formatter->format(entry));
+        }
+
+        bool acceptsFormattedOutput() const override {
+            return true;
+        }
+    };
+}
+
+class FaultInjectionTest : public ::testing::Test {
+};
+
+TEST_F(FaultInjectionTest, PassesWritesThroughWithoutFaults) {
+    std::vector<std::string> records;
+    minta::FaultInjectingTransport transport(minta::make_unique<RecordingTransport>(records), minta::FaultOptions());
+
+    transport.write("first");
+    transport.write("second");
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1], "second");
+    EXPECT_EQ(transport.writes(), 2u);
+    EXPECT_EQ(transport.failures(), 0u);
+}
+
+TEST_F(FaultInjectionTest, InjectsPeriodicFailuresAndPartialWrites) {
+    std::vector<std::string> records;
+    minta::FaultOptions options;
+    options.failEvery = 3;
+    options.partialEvery = 2;
+    minta::FaultInjectingTransport transport(minta::make_unique<RecordingTransport>(records), options);
+
+    for (int i = 1; i <= 6; ++i) {
+        if (i % 3 == 0) {
+            EXPECT_THROW(transport.write("abcdefgh"), std::runtime_error);
+        } else {
+            transport.write("abcdefgh");
+        }
+    }
+
+    // Writes 1, 2, 4 and 5 reach the inner transport; 2 and 4 are truncated.
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records[0], "abcdefgh");
+    EXPECT_EQ(records[1], "abcd");
+    EXPECT_EQ(records[2], "abcd");
+    EXPECT_EQ(records[3], "abcdefgh");
+    EXPECT_EQ(transport.failures(), 2u);
+    EXPECT_EQ(transport.partialWrites(), 2u);
+}
+
+TEST_F(FaultInjectionTest, AddsLatencyAndStalls) {
+    std::vector<std::string> records;
+    minta::FaultOptions options;
+    options.latency = std::chrono::microseconds(1000);
+    options.stallEvery = 2;
+    options.stallDuration = std::chrono::milliseconds(20);
+    minta::FaultInjectingTransport transport(minta::make_unique<RecordingTransport>(records), options);
+
+    auto start = std::chrono::steady_clock::now();
+    transport.write("a");
+    transport.write("b");
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_GE(elapsed, std::chrono::milliseconds(22));
+    EXPECT_EQ(transport.stalls(), 1u);
+    EXPECT_EQ(records.size(), 2u);
+}
+
+TEST_F(FaultInjectionTest, FailingSinkDoesNotAffectOtherSinks) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    logger.setRateLimit(0);
+    minta::FaultOptions options;
+    options.failEvery = 4;
+    logger.addSink<FaultySink>(options);
+    auto sink = minta::make_unique<minta::MemorySink>(256);
+    minta::MemorySink *memory = sink.get();
+    logger.addCustomSink(std::move(sink));
+
+    for (int i = 0; i < 100; ++i) {
+        logger.info("Message {index}", i);
+    }
+    ASSERT_TRUE(memory->waitFor(100));
+
+    minta::LogStats stats = logger.getStats();
+    ASSERT_EQ(stats.sinks.size(), 2u);
+    EXPECT_EQ(stats.sinks[0].errors, 25u);
+    EXPECT_EQ(stats.sinks[0].entries + stats.sinks[0].errors, 100u);
+    EXPECT_EQ(stats.sinks[1].errors, 0u);
+    EXPECT_EQ(stats.sinks[1].entries, 100u);
+}
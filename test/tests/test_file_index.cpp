@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+
+class FileIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override { TestUtils::cleanupLogFiles(); }
+    void TearDown() override { TestUtils::cleanupLogFiles(); }
+
+    static std::chrono::system_clock::time_point timeOf(int index) {
+        return std::chrono::system_clock::from_time_t(1700000000) + std::chrono::milliseconds(123) +
+               std::chrono::seconds(index);
+    }
+
+    static void writeEntries(minta::FileSink &sink, int count, int first = 0, const std::string &prefix = "message ") {
+        for (int i = first; i < first + count; ++i) {
+            minta::LogEntry entry;
+            entry.level = minta::LogLevel::INFO;
+            entry.message = prefix + std::to_string(i);
+            entry.templateStr = "message {index}";
+            entry.arguments = {{"index", std::to_string(i)}};
+            entry.timestamp = timeOf(i);
+            entry.line = 0;
+            sink.write(entry);
+        }
+    }
+
+    static std::vector<std::string> linesInRange(int64_t from, int64_t to) {
+        minta::MappedFile log("index_log.txt");
+        minta::MappedFile indexFile("index_log.txt.idx");
+        minta::FileIndex index(indexFile.data(), indexFile.size());
+        EXPECT_TRUE(index.valid());
+
+        std::vector<std::string> lines;
+        index.forEachLineInRange(log.data(), log.size(), from, to, [&](const char *line, size_t length) {
+            lines.push_back(std::string(line, length));
+        });
+        return lines;
+    }
+};
+
+TEST_F(FileIndexTest, RecordsPointEveryNEntries) {
+    {
+        minta::FileSink sink("index_log.txt", minta::FileIndexOptions(10, std::chrono::hours(1)));
+        writeEntries(sink, 95);
+    }
+    std::string log = TestUtils::readLogFile("index_log.txt");
+    std::string indexData = TestUtils::readLogFile("index_log.txt.idx");
+    minta::FileIndex index(indexData.data(), indexData.size());
+
+    ASSERT_TRUE(index.valid());
+    ASSERT_EQ(index.points().size(), 10u);
+    EXPECT_EQ(index.points()[0].offset, 0u);
+    for (size_t i = 0; i < index.points().size(); ++i) {
+        const minta::FileIndexPoint &point = index.points()[i];
+        EXPECT_EQ(point.timestamp, minta::toEpochNanos(timeOf(static_cast<int>(i * 10))));
+        std::string line = log.substr(point.offset, log.find('\n', point.offset) - point.offset);
+        EXPECT_NE(line.find("message " + std::to_string(i * 10)), std::string::npos);
+    }
+}
+
+TEST_F(FileIndexTest, RecordsPointEveryInterval) {
+    {
+        minta::FileSink sink("index_log.txt", minta::FileIndexOptions(1000, std::chrono::seconds(5)));
+        writeEntries(sink, 20);
+    }
+    std::string indexData = TestUtils::readLogFile("index_log.txt.idx");
+    minta::FileIndex index(indexData.data(), indexData.size());
+    ASSERT_EQ(index.points().size(), 4u);
+    EXPECT_EQ(index.points()[1].timestamp, minta::toEpochNanos(timeOf(5)));
+}
+
+TEST_F(FileIndexTest, ByteRangeCoversRequestedWindowOnly) {
+    {
+        minta::FileSink sink("index_log.txt", minta::FileIndexOptions(10, std::chrono::hours(1)));
+        writeEntries(sink, 100);
+    }
+    std::string indexData = TestUtils::readLogFile("index_log.txt.idx");
+    minta::FileIndex index(indexData.data(), indexData.size());
+    uint64_t fileSize = TestUtils::readLogFile("index_log.txt").size();
+
+    std::pair<uint64_t, uint64_t> range = index.byteRange(minta::toEpochNanos(timeOf(42)),
+                                                          minta::toEpochNanos(timeOf(47)), fileSize);
+    EXPECT_EQ(range.first, index.points()[4].offset);
+    EXPECT_EQ(range.second, index.points()[5].offset);
+
+    range = index.byteRange(minta::toEpochNanos(timeOf(95)), minta::toEpochNanos(timeOf(200)), fileSize);
+    EXPECT_EQ(range.first, index.points()[9].offset);
+    EXPECT_EQ(range.second, fileSize);
+}
+
+TEST_F(FileIndexTest, ScansHumanReadableLinesInRange) {
+    {
+        minta::FileSink sink("index_log.txt", minta::FileIndexOptions(10, std::chrono::hours(1)));
+        writeEntries(sink, 100);
+    }
+    std::vector<std::string> lines = linesInRange(minta::toEpochNanos(timeOf(38)), minta::toEpochNanos(timeOf(52)));
+    ASSERT_EQ(lines.size(), 15u);
+    EXPECT_NE(lines.front().find("message 38"), std::string::npos);
+    EXPECT_NE(lines.back().find("message 52"), std::string::npos);
+}
+
+TEST_F(FileIndexTest, ScansJsonLinesInRange) {
+    {
+        minta::FileSink sink("index_log.txt", minta::FileIndexOptions(10, std::chrono::hours(1)));
+        sink.setFormatter(std::make_shared<minta::JsonFormatter>());
+        writeEntries(sink, 50);
+    }
+    std::vector<std::string> lines = linesInRange(minta::toEpochNanos(timeOf(20)), minta::toEpochNanos(timeOf(21)));
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_NE(lines[0].find("\"message\":\"message 20\""), std::string::npos);
+    EXPECT_NE(lines[1].find("\"message\":\"message 21\""), std::string::npos);
+}
+
+TEST_F(FileIndexTest, FindsEntriesDumpedBetweenIndexPoints) {
+    {
+        minta::FileSink sink("index_log.txt", minta::FileIndexOptions(10, std::chrono::hours(1)));
+        writeEntries(sink, 35);
+        // A backtrace dump: older timestamps written after newer entries.
+        writeEntries(sink, 3, 12, "dumped ");
+        writeEntries(sink, 15, 35);
+    }
+    std::string indexData = TestUtils::readLogFile("index_log.txt.idx");
+    minta::FileIndex index(indexData.data(), indexData.size());
+    ASSERT_TRUE(index.valid());
+    for (size_t i = 1; i < index.points().size(); ++i) {
+        EXPECT_LE(index.points()[i - 1].timestamp, index.points()[i].timestamp);
+    }
+
+    std::vector<std::string> lines = linesInRange(minta::toEpochNanos(timeOf(12)), minta::toEpochNanos(timeOf(14)));
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_NE(lines[0].find("message 12"), std::string::npos);
+    EXPECT_NE(lines[3].find("dumped 12"), std::string::npos);
+    EXPECT_NE(lines[5].find("dumped 14"), std::string::npos);
+
+    lines = linesInRange(minta::toEpochNanos(timeOf(33)), minta::toEpochNanos(timeOf(36)));
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_NE(lines[0].find("message 33"), std::string::npos);
+    EXPECT_NE(lines[3].find("message 36"), std::string::npos);
+}
+
+TEST_F(FileIndexTest, MissingIndexScansWholeFile) {
+    {
+        minta::FileSink sink("index_log.txt");
+        writeEntries(sink, 10);
+    }
+    minta::MappedFile log("index_log.txt");
+    minta::FileIndex index(nullptr, 0);
+    EXPECT_FALSE(index.valid());
+
+    size_t count = 0;
+    index.forEachLineInRange(log.data(), log.size(), minta::toEpochNanos(timeOf(3)), minta::toEpochNanos(timeOf(5)),
+                             [&](const char *, size_t) { ++count; });
+    EXPECT_EQ(count, 3u);
+}
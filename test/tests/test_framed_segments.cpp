@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+
+class FramedSegmentsTest : public ::testing::Test {
+protected:
+    void SetUp() override { TestUtils::cleanupLogFiles(); }
+    void TearDown() override { TestUtils::cleanupLogFiles(); }
+
+    static std::string writeSegments(int records, size_t segmentBytes) {
+        {
+            minta::FramedFileTransport transport("framed_log.bin", segmentBytes);
+            for (int i = 0; i < records; ++i) {
+                transport.write("record " + std::to_string(i));
+            }
+        }
+        return TestUtils::readLogFile("framed_log.bin");
+    }
+
+    static std::vector<std::string> allRecords(const minta::FramedLogReader &reader) {
+        std::vector<std::string> records;
+        reader.forEachRecord([&](const std::string &record) { records.push_back(record); });
+        return records;
+    }
+};
+
+TEST_F(FramedSegmentsTest, Crc32cMatchesReferenceValue) {
+    const std::string input = "123456789";
+    EXPECT_EQ(minta::crc32c(input.data(), input.size()), 0xE3069283u);
+    EXPECT_EQ(~minta::detail::crc32cSoftware(~0u, reinterpret_cast<const unsigned char *>(input.data()), input.size()),
+              0xE3069283u);
+
+    std::string longer(1000, 'x');
+    uint32_t whole = minta::crc32c(longer.data(), longer.size());
+    uint32_t pieces = minta::crc32c(longer.data() + 3, longer.size() - 3, minta::crc32c(longer.data(), 3));
+    EXPECT_EQ(whole, pieces);
+}
+
+TEST_F(FramedSegmentsTest, ReadsBackAllRecords) {
+    std::string data = writeSegments(10, 18);
+    minta::FramedLogReader reader(data.data(), data.size());
+
+    EXPECT_EQ(reader.segments().size(), 5u);
+    EXPECT_EQ(reader.segments().back().sequence, 4u);
+    EXPECT_FALSE(reader.report().tornTail);
+    EXPECT_TRUE(reader.report().gaps.empty());
+    EXPECT_EQ(reader.report().validLength, data.size());
+
+    std::vector<std::string> records = allRecords(reader);
+    ASSERT_EQ(records.size(), 10u);
+    EXPECT_EQ(records.front(), "record 0");
+    EXPECT_EQ(records.back(), "record 9");
+}
+
+TEST_F(FramedSegmentsTest, RecoversFromTornTail) {
+    std::string data = writeSegments(10, 18);
+    size_t fullLength = data.size();
+    data.resize(fullLength - 5);
+
+    minta::FramedLogReader reader(data.data(), data.size());
+    EXPECT_EQ(reader.segments().size(), 4u);
+    EXPECT_TRUE(reader.report().tornTail);
+    EXPECT_EQ(reader.report().validLength, reader.segments().back().payloadOffset + reader.segments().back().payloadSize);
+    EXPECT_EQ(allRecords(reader).size(), 8u);
+}
+
+TEST_F(FramedSegmentsTest, SkipsCorruptSegmentAndReportsGap) {
+    std::string data = writeSegments(10, 18);
+    minta::FramedLogReader intact(data.data(), data.size());
+    const minta::FramedSegmentInfo &victim = intact.segments()[2];
+    data[victim.payloadOffset + 1] ^= 0x40;
+
+    minta::FramedLogReader reader(data.data(), data.size());
+    EXPECT_EQ(reader.segments().size(), 4u);
+    EXPECT_EQ(reader.report().corruptRegions, 1u);
+    EXPECT_FALSE(reader.report().tornTail);
+    ASSERT_EQ(reader.report().gaps.size(), 1u);
+    EXPECT_EQ(reader.report().gaps[0].after, 1u);
+    EXPECT_EQ(reader.report().gaps[0].next, 3u);
+    EXPECT_EQ(allRecords(reader).size(), 8u);
+}
+
+TEST_F(FramedSegmentsTest, SplitsAtSegmentBoundariesForParallelScans) {
+    std::string data = writeSegments(40, 18);
+    std::vector<size_t> starts = minta::FramedLogReader::splitAtSegments(data.data(), data.size(), 4);
+    ASSERT_EQ(starts.size(), 4u);
+    EXPECT_EQ(starts[0], 0u);
+
+    size_t total = 0;
+    for (size_t i = 0; i < starts.size(); ++i) {
+        size_t end = i + 1 < starts.size() ? starts[i + 1] : data.size();
+        minta::FramedLogReader part(data.data() + starts[i], end - starts[i]);
+        EXPECT_FALSE(part.report().tornTail);
+        total += allRecords(part).size();
+    }
+    EXPECT_EQ(total, 40u);
+}
+
+TEST_F(FramedSegmentsTest, FramedFileSinkThroughLogger) {
+    {
+        minta::LunarLog logger(minta::LogLevel::INFO);
+        logger.addSink<minta::FramedFileSink, minta::JsonFormatter>("framed_log.bin");
+        logger.info("Order {id} shipped", 42);
+    }
+
+    std::string data = TestUtils::readLogFile("framed_log.bin");
+    minta::FramedLogReader reader(data.data(), data.size());
+    std::vector<std::string> records = allRecords(reader);
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_NE(records[0].find("\"message\":\"Order 42 shipped\""), std::string::npos);
+}
+
+TEST_F(FramedSegmentsTest, FramedFileSinkWritesEachRecordWithoutDestruction) {
+    minta::LunarLog logger(minta::LogLevel::INFO);
+    logger.addSink<minta::FramedFileSink>("framed_log.bin");
+    for (int i = 0; i < 3; ++i) {
+        logger.info("Order {id} shipped", i);
+    }
+
+    std::vector<std::string> records;
+    for (int attempt = 0; attempt < 100 && records.size() < 3; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        std::string data = TestUtils::readLogFile("framed_log.bin");
+        minta::FramedLogReader reader(data.data(), data.size());
+        records = allRecords(reader);
+    }
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_NE(records[2].find("Order 2 shipped"), std::string::npos);
+}
+
+TEST_F(FramedSegmentsTest, FramedFileSinkFlushSealsOpenSegment) {
+    minta::FramedFileSink sink("framed_log.bin", 4096);
+    minta::LogEntry entry;
+    entry.level = minta::LogLevel::INFO;
+    entry.message = "buffered";
+    entry.timestamp = std::chrono::system_clock::now();
+    entry.line = 0;
+    sink.write(entry);
+    sink.write(entry);
+    EXPECT_TRUE(TestUtils::readLogFile("framed_log.bin").empty());
+
+    sink.flush();
+    std::string data = TestUtils::readLogFile("framed_log.bin");
+    minta::FramedLogReader reader(data.data(), data.size());
+    EXPECT_EQ(reader.segments().size(), 1u);
+    EXPECT_EQ(allRecords(reader).size(), 2u);
+}
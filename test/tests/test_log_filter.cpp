@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+
+class LogFilterTest : public ::testing::Test {
+protected:
+    static minta::LogEntry makeEntry(minta::LogLevel level, const std::string &templateStr) {
+        minta::LogEntry entry;
+        entry.level = level;
+        entry.templateStr = templateStr;
+        entry.message = templateStr;
+        entry.line = 0;
+        return entry;
+    }
+};
+
+TEST_F(LogFilterTest, LevelComparisons) {
+    minta::LogFilter filter("level >= WARN");
+    EXPECT_FALSE(filter.matches(makeEntry(minta::LogLevel::INFO, "a")));
+    EXPECT_TRUE(filter.matches(makeEntry(minta::LogLevel::WARN, "a")));
+    EXPECT_TRUE(filter.matches(makeEntry(minta::LogLevel::FATAL, "a")));
+
+    EXPECT_TRUE(minta::LogFilter("level == debug").matches(makeEntry(minta::LogLevel::DEBUG, "a")));
+    EXPECT_TRUE(minta::LogFilter("level < INFO").matches(makeEntry(minta::LogLevel::TRACE, "a")));
+    EXPECT_FALSE(minta::LogFilter("level != ERROR").matches(makeEntry(minta::LogLevel::ERROR, "a")));
+}
+
+TEST_F(LogFilterTest, ContextAndArguments) {
+    minta::LogEntry entry = makeEntry(minta::LogLevel::INFO, "Order {id} placed");
+    entry.customContext["tenant"] = "acme";
+    entry.arguments.emplace_back("id", "42");
+
+    EXPECT_TRUE(minta::LogFilter("ctx.tenant == \"acme\"").matches(entry));
+    EXPECT_FALSE(minta::LogFilter("ctx.tenant != \"acme\"").matches(entry));
+    EXPECT_TRUE(minta::LogFilter("ctx.tenant").matches(entry));
+    EXPECT_FALSE(minta::LogFilter("ctx.region").matches(entry));
+    EXPECT_FALSE(minta::LogFilter("ctx.region == \"eu\"").matches(entry));
+    EXPECT_TRUE(minta::LogFilter("ctx.region != \"eu\"").matches(entry));
+    EXPECT_TRUE(minta::LogFilter("arg.id == 42").matches(entry));
+    EXPECT_TRUE(minta::LogFilter("arg.id ~ \"4?\"").matches(entry));
+}
+
+TEST_F(LogFilterTest, GlobMatching) {
+    minta::LogFilter filter("template ~ \"payment*\"");
+    EXPECT_TRUE(filter.matches(makeEntry(minta::LogLevel::INFO, "payment {id} failed")));
+    EXPECT_FALSE(filter.matches(makeEntry(minta::LogLevel::INFO, "refund {id}")));
+
+    EXPECT_TRUE(minta::LogFilter("message ~ \"*fail*\"").matches(makeEntry(minta::LogLevel::INFO, "it failed")));
+    EXPECT_TRUE(minta::LogFilter("message !~ \"*fail*\"").matches(makeEntry(minta::LogLevel::INFO, "ok")));
+    EXPECT_TRUE(minta::LogFilter("message ~ \"a*b*c\"").matches(makeEntry(minta::LogLevel::INFO, "axxbyyc")));
+    EXPECT_FALSE(minta::LogFilter("message ~ \"a*b*c\"").matches(makeEntry(minta::LogLevel::INFO, "axxbyy")));
+}
+
+TEST_F(LogFilterTest, BooleanOperatorsAndPrecedence) {
+    minta::LogFilter filter("level >= WARN || ctx.tenant == \"acme\" && !(template ~ \"health*\")");
+    minta::LogEntry entry = makeEntry(minta::LogLevel::INFO, "health check");
+    entry.customContext["tenant"] = "acme";
+    EXPECT_FALSE(filter.matches(entry));
+    entry.templateStr = "request served";
+    EXPECT_TRUE(filter.matches(entry));
+    entry.customContext.clear();
+    EXPECT_FALSE(filter.matches(entry));
+    entry.level = minta::LogLevel::ERROR;
+    EXPECT_TRUE(filter.matches(entry));
+
+    EXPECT_TRUE(minta::LogFilter("true").matches(entry));
+    EXPECT_FALSE(minta::LogFilter("!true").matches(entry));
+}
+
+TEST_F(LogFilterTest, InvalidExpressionsThrow) {
+    EXPECT_THROW(minta::LogFilter(""), std::invalid_argument);
+    EXPECT_THROW(minta::LogFilter("level >= LOUD"), std::invalid_argument);
+    EXPECT_THROW(minta::LogFilter("severity >= WARN"), std::invalid_argument);
+    EXPECT_THROW(minta::LogFilter("level >= WARN ||"), std::invalid_argument);
+    EXPECT_THROW(minta::LogFilter("(level >= WARN"), std::invalid_argument);
+    EXPECT_THROW(minta::LogFilter("ctx.tenant == \"acme"), std::invalid_argument);
+    EXPECT_THROW(minta::LogFilter("message < \"x\""), std::invalid_argument);
+    EXPECT_THROW(minta::LogFilter("level"), std::invalid_argument);
+
+    try {
+        minta::LogFilter("level >= WARN &&& x");
+        FAIL() << "expected std::invalid_argument";
+    } catch (const std::invalid_argument &error) {
+        EXPECT_NE(std::string(error.what()).find("position"), std::string::npos);
+    }
+}
+
+TEST_F(LogFilterTest, LoggerAndSinkFilters) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    minta::SinkId allId;
+    minta::SinkId acmeId;
+    minta::MemorySink *all = TestUtils::addMemorySink(logger, &allId);
+    minta::MemorySink *acme = TestUtils::addMemorySink(logger, &acmeId);
+    logger.setFilter("template !~ \"heartbeat*\"");
+    EXPECT_TRUE(logger.setSinkFilter(acmeId, "ctx.tenant == \"acme\""));
+    EXPECT_FALSE(logger.setSinkFilter(acmeId + 100, "true"));
+    EXPECT_THROW(logger.setSinkFilter(acmeId, "ctx.tenant =="), std::invalid_argument);
+
+    logger.info("heartbeat {n}", 1);
+    logger.setContext("tenant", "acme");
+    logger.info("order placed");
+    logger.setContext("tenant", "globex");
+    logger.info("order cancelled");
+
+    ASSERT_TRUE(all->waitFor(2));
+    ASSERT_TRUE(acme->waitFor(1));
+    std::vector<std::string> allRecords = all->drain();
+    std::vector<std::string> acmeRecords = acme->drain();
+    ASSERT_EQ(allRecords.size(), 2u);
+    EXPECT_NE(allRecords[0].find("order placed"), std::string::npos);
+    ASSERT_EQ(acmeRecords.size(), 1u);
+    EXPECT_NE(acmeRecords[0].find("order placed"), std::string::npos);
+
+    logger.setFilter("");
+    logger.info("heartbeat {n}", 2);
+    ASSERT_TRUE(all->waitFor(1));
+    EXPECT_NE(all->drain()[0].find("heartbeat 2"), std::string::npos);
+}
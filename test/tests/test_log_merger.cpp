@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+
+class LogMergerTest : public ::testing::Test {
+protected:
+    static minta::LogEntry makeEntry(int index, const std::string &source) {
+        minta::LogEntry entry;
+        entry.level = index % 2 == 0 ? minta::LogLevel::INFO : minta::LogLevel::ERROR;
+        entry.timestamp = std::chrono::system_clock::from_time_t(1700000000) + std::chrono::milliseconds(10 * index);
+        entry.templateStr = "Event {index} from {source}";
+        entry.arguments = {{"index", std::to_string(index)}, {"source", source}};
+        entry.message = "Event " + std::to_string(index) + " from " + source;
+        entry.line = 0;
+        entry.customContext["source"] = source;
+        return entry;
+    }
+
+    static std::string writeText(const minta::IFormatter &formatter, const std::vector<int> &indices,
+                                 const std::string &source) {
+        std::string data;
+        for (int index : indices) {
+            data += formatter.format(makeEntry(index, source));
+            data += '\n';
+        }
+        return data;
+    }
+};
+
+TEST_F(LogMergerTest, MergesMixedFormatsInTimestampOrder) {
+    std::vector<int> first, second, third;
+    for (int i = 0; i < 60; ++i) {
+        (i % 3 == 0 ? first : i % 3 == 1 ? second : third).push_back(i);
+    }
+    std::string human = writeText(minta::HumanReadableFormatter(), first, "human");
+    std::string xml = writeText(minta::XmlFormatter(), second, "xml");
+    minta::BinaryFormatter binaryFormatter;
+    std::string binary;
+    for (int index : third) {
+        binaryFormatter.formatTo(makeEntry(index, "binary"), binary);
+    }
+
+    minta::LogMerger merger;
+    merger.addInput(human.data(), human.size());
+    merger.addInput(xml.data(), xml.size());
+    merger.addInput(binary.data(), binary.size());
+
+    std::vector<std::string> messages;
+    std::vector<size_t> inputs;
+    size_t count = merger.merge([&](const minta::LogEntry &entry, size_t input) {
+        messages.push_back(entry.message);
+        inputs.push_back(input);
+        EXPECT_EQ(entry.customContext.at("source"), input == 0 ? "human" : input == 1 ? "xml" : "binary");
+    });
+
+    ASSERT_EQ(count, 60u);
+    EXPECT_EQ(merger.skipped(), 0u);
+    for (int i = 0; i < 60; ++i) {
+        EXPECT_EQ(inputs[i], static_cast<size_t>(i % 3));
+        EXPECT_EQ(messages[i].compare(0, 6 + std::to_string(i).size() + 1, "Event " + std::to_string(i) + " "), 0);
+    }
+}
+
+TEST_F(LogMergerTest, EqualTimestampsKeepInputOrder) {
+    std::string a = writeText(minta::JsonFormatter(), {1, 2}, "a");
+    std::string b = writeText(minta::JsonFormatter(), {1, 2}, "b");
+
+    minta::LogMerger merger;
+    merger.addInput(a.data(), a.size());
+    merger.addInput(b.data(), b.size());
+    std::vector<size_t> inputs;
+    merger.merge([&](const minta::LogEntry &, size_t input) { inputs.push_back(input); });
+    EXPECT_EQ(inputs, (std::vector<size_t>{0, 1, 0, 1}));
+}
+
+TEST_F(LogMergerTest, SortsDumpedBacktraceWithinWindow) {
+    // Entries 3-5 arrive late, as a dumped backtrace would write them.
+    std::string data = writeText(minta::JsonFormatter(), {0, 1, 2, 6, 7, 8, 3, 4, 5, 9}, "a");
+    std::vector<int> expected = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    minta::LogMerger merger;
+    merger.addInput(data.data(), data.size());
+    std::vector<int> order;
+    merger.merge([&](const minta::LogEntry &entry, size_t) { order.push_back(std::stoi(entry.message.substr(6))); });
+    EXPECT_EQ(order, expected);
+    EXPECT_EQ(merger.outOfOrder(), 0u);
+
+    minta::LogMerger narrow(2);
+    narrow.addInput(data.data(), data.size());
+    order.clear();
+    narrow.merge([&](const minta::LogEntry &entry, size_t) { order.push_back(std::stoi(entry.message.substr(6))); });
+    EXPECT_EQ(order.size(), 10u);
+    EXPECT_GT(narrow.outOfOrder(), 0u);
+}
+
+TEST_F(LogMergerTest, ReformatsTextEntriesFaithfully) {
+    minta::LogEntry entry = makeEntry(4, "json");
+    entry.message = "quote \" backslash \\ tab \t <tag> & done";
+    entry.file = "main.cpp";
+    entry.line = 12;
+    entry.function = "run";
+    minta::JsonFormatter json;
+    minta::XmlFormatter xml;
+    std::string data = json.format(entry) + "\nnot a log line\n" + xml.format(entry) + "\n";
+
+    minta::LogMerger merger;
+    merger.addInput(data.data(), data.size());
+    std::vector<std::string> lines;
+    merger.merge([&](const minta::LogEntry &merged, size_t) { lines.push_back(json.format(merged)); });
+
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], json.format(entry));
+    EXPECT_EQ(lines[1], json.format(entry));
+    EXPECT_EQ(merger.skipped(), 1u);
+}
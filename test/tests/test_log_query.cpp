@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+
+class LogQueryTest : public ::testing::Test {
+protected:
+    static std::chrono::system_clock::time_point timeOf(int index) {
+        return std::chrono::system_clock::from_time_t(1700000000) + std::chrono::milliseconds(250 * index);
+    }
+
+    static minta::LogEntry makeEntry(int index) {
+        static const minta::LogLevel levels[] = {minta::LogLevel::DEBUG, minta::LogLevel::INFO,
+                                                 minta::LogLevel::WARN, minta::LogLevel::ERROR};
+        minta::LogEntry entry;
+        entry.level = levels[index % 4];
+        entry.timestamp = timeOf(index);
+        entry.templateStr = "User {name} made request {id}";
+        entry.message = "User user" + std::to_string(index % 3) + " made request " + std::to_string(index);
+        entry.line = 0;
+        if (index % 2 == 0) {
+            entry.file = "service.cpp";
+            entry.line = 40 + index;
+            entry.function = "handle";
+        }
+        if (index % 5 == 0) {
+            entry.customContext["tenant"] = index % 10 == 0 ? "acme" : "globex";
+            entry.customContext["region"] = "eu";
+        }
+        return entry;
+    }
+
+    static std::string writeLines(const minta::IFormatter &formatter, int count) {
+        std::string data;
+        for (int i = 0; i < count; ++i) {
+            data += formatter.format(makeEntry(i));
+            data += '\n';
+        }
+        return data;
+    }
+
+    static std::vector<std::string> query(const std::string &data, const minta::LogQuery &query, unsigned threads = 1,
+                                          size_t chunkBytes = 1 << 20) {
+        std::vector<std::string> lines;
+        minta::LogLineFilter filter(query);
+        size_t count = minta::scanLines(data.data(), data.size(), filter, [&](const char *line, size_t length) {
+            lines.push_back(std::string(line, length));
+        }, threads, chunkBytes);
+        EXPECT_EQ(count, lines.size());
+        return lines;
+    }
+};
+
+TEST_F(LogQueryTest, ParsesAllBuiltInFormats) {
+    minta::LogEntry entry = makeEntry(10);
+    entry.message = "say \"hi\" <now> & later";
+
+    minta::HumanReadableFormatter human;
+    minta::JsonFormatter json;
+    minta::XmlFormatter xml;
+    const minta::IFormatter *formatters[] = {&human, &json, &xml};
+    for (const minta::IFormatter *formatter : formatters) {
+        std::string line = formatter->format(entry);
+        minta::LogLineView view;
+        ASSERT_TRUE(minta::parseLogLine(line.data(), line.size(), view)) << line;
+        EXPECT_EQ(view.level, minta::LogLevel::WARN);
+        EXPECT_EQ(std::string(view.timestamp, minta::timestampTextLength()), minta::formatTimestamp(entry.timestamp));
+
+        std::string message;
+        minta::appendUnescaped(view.format, view.message, message);
+        EXPECT_EQ(message, entry.message) << line;
+        EXPECT_TRUE(view.file.equals("service.cpp", 11)) << line;
+        EXPECT_EQ(view.line, 50);
+        EXPECT_TRUE(view.function.equals("handle", 6)) << line;
+
+        std::map<std::string, std::string> context;
+        minta::forEachContextValue(view, [&](const minta::TextSpan &key, const minta::TextSpan &value) {
+            context[std::string(key.data, key.size)] = std::string(value.data, value.size);
+            return true;
+        });
+        EXPECT_EQ(context, entry.customContext) << line;
+    }
+}
+
+TEST_F(LogQueryTest, RejectsUnknownLines) {
+    minta::LogLineView view;
+    const std::string garbage[] = {"", "hello world", "{\"foo\":1}", "<log_entry><level>LOUD</level>",
+                                   "2024-01-01 00:00:00.000 [NOPE] message"};
+    for (const auto &line : garbage) {
+        EXPECT_FALSE(minta::parseLogLine(line.data(), line.size(), view)) << line;
+    }
+}
+
+TEST_F(LogQueryTest, TemplateMatcher) {
+    minta::TemplateMatcher matcher("User {name} made request {id}");
+    EXPECT_TRUE(matcher.matches("User bob made request 7", 23));
+    EXPECT_FALSE(matcher.matches("User bob made a request 7", 25));
+    EXPECT_FALSE(matcher.matches("Admin bob made request 7", 24));
+
+    minta::TemplateMatcher prefix("payment*");
+    EXPECT_TRUE(prefix.matches("payment failed", 14));
+    EXPECT_FALSE(prefix.matches("no payment", 10));
+
+    minta::TemplateMatcher braces("set {{x}} to {value}");
+    EXPECT_TRUE(braces.matches("set {x} to 3", 12));
+    EXPECT_FALSE(braces.matches("set x to 3", 10));
+
+    minta::TemplateMatcher exact("done");
+    EXPECT_TRUE(exact.matches("done", 4));
+    EXPECT_FALSE(exact.matches("done!", 5));
+}
+
+TEST_F(LogQueryTest, FiltersByLevelTimeTemplateAndContext) {
+    minta::HumanReadableFormatter human;
+    minta::JsonFormatter json;
+    minta::XmlFormatter xml;
+    const minta::IFormatter *formatters[] = {&human, &json, &xml};
+    for (const minta::IFormatter *formatter : formatters) {
+        std::string data = writeLines(*formatter, 40);
+
+        minta::LogQuery levelQuery;
+        levelQuery.minLevel = minta::LogLevel::ERROR;
+        EXPECT_EQ(query(data, levelQuery).size(), 10u);
+
+        minta::LogQuery timeQuery;
+        timeQuery.from = minta::toEpochNanos(timeOf(8));
+        timeQuery.to = minta::toEpochNanos(timeOf(11));
+        std::vector<std::string> lines = query(data, timeQuery);
+        ASSERT_EQ(lines.size(), 4u);
+        EXPECT_NE(lines.front().find("request 8"), std::string::npos);
+
+        minta::LogQuery templateQuery;
+        templateQuery.messageTemplate = "User user1 made request {id}";
+        EXPECT_EQ(query(data, templateQuery).size(), 13u);
+
+        minta::LogQuery contextQuery;
+        contextQuery.contextKey = "tenant";
+        EXPECT_EQ(query(data, contextQuery).size(), 8u);
+        contextQuery.contextValue = "acme";
+        EXPECT_EQ(query(data, contextQuery).size(), 4u);
+    }
+}
+
+TEST_F(LogQueryTest, ParallelScanKeepsFileOrder) {
+    minta::JsonFormatter json;
+    std::string data = writeLines(json, 2000);
+    minta::LogQuery warnings;
+    warnings.minLevel = minta::LogLevel::WARN;
+
+    std::vector<std::string> serial = query(data, warnings, 1, data.size());
+    std::vector<std::string> parallel = query(data, warnings, 4, 4096);
+    EXPECT_EQ(serial.size(), 1000u);
+    EXPECT_EQ(serial, parallel);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+#include <atomic>
+#include <numeric>
+#include <thread>
+
+namespace {
+    // Blocks the worker thread inside write() until released.
+    class GateSink : public minta::ISink {
+    public:
+        GateSink(std::atomic<bool> &entered, std::atomic<bool> &released)
+            : m_entered(entered), m_released(released) {
+        }
+
+        void write(const minta::LogEntry &) override {
+            m_entered = true;
+            while (!m_released) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+    private:
+        std::atomic<bool> &m_entered;
+        std::atomic<bool> &m_released;
+    };
+}
+
+class LogStatsTest : public ::testing::Test {
+};
+
+TEST_F(LogStatsTest, CountsEntriesAndBytesPerSink) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger);
+
+    for (int i = 0; i < 50; ++i) {
+        logger.info("Message {index}", i);
+    }
+    logger.debug("Filtered by level");
+    ASSERT_TRUE(memory->waitFor(50));
+
+    std::vector<std::string> records = memory->drain();
+    size_t bytes = 0;
+    for (const auto &record : records) bytes += record.size();
+
+    minta::LogStats stats = logger.getStats();
+    EXPECT_EQ(stats.enqueued, 50u);
+    EXPECT_EQ(stats.droppedRateLimited, 0u);
+    EXPECT_EQ(stats.droppedOverflow, 0u);
+    EXPECT_GE(stats.queueHighWater, 1u);
+    EXPECT_GT(stats.workerBusyNanos, 0u);
+    ASSERT_EQ(stats.sinks.size(), 1u);
+    EXPECT_EQ(stats.sinks[0].entries, 50u);
+    EXPECT_EQ(stats.sinks[0].bytes, bytes);
+    EXPECT_EQ(std::accumulate(stats.sinks[0].writeLatency.begin(), stats.sinks[0].writeLatency.end(), uint64_t(0)), 50u);
+}
+
+TEST_F(LogStatsTest, CountsRateLimitedDrops) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    logger.setRateLimit(10);
+    for (int i = 0; i < 25; ++i) {
+        logger.info("Message {index}", i);
+    }
+    minta::LogStats stats = logger.getStats();
+    EXPECT_EQ(stats.enqueued, 10u);
+    EXPECT_EQ(stats.droppedRateLimited, 15u);
+}
+
+TEST_F(LogStatsTest, CountsOverflowDropsAndHighWater) {
+    std::atomic<bool> entered(false);
+    std::atomic<bool> released(false);
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    logger.setMaxQueueSize(5);
+    logger.addSink<GateSink>(entered, released);
+
+    logger.info("Blocks the worker");
+    while (!entered) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (int i = 0; i < 10; ++i) {
+        logger.info("Message {index}", i);
+    }
+
+    minta::LogStats stats = logger.getStats();
+    EXPECT_EQ(stats.enqueued, 6u);
+    EXPECT_EQ(stats.droppedOverflow, 5u);
+    EXPECT_EQ(stats.queueDepth, 5u);
+    EXPECT_EQ(stats.queueHighWater, 5u);
+    released = true;
+}
+
+TEST_F(LogStatsTest, LatencyBuckets) {
+    EXPECT_EQ(minta::SinkCounters::bucketFor(0), 0u);
+    EXPECT_EQ(minta::SinkCounters::bucketFor(1), 0u);
+    EXPECT_EQ(minta::SinkCounters::bucketFor(2), 1u);
+    EXPECT_EQ(minta::SinkCounters::bucketFor(1023), 9u);
+    EXPECT_EQ(minta::SinkCounters::bucketFor(1024), 10u);
+    EXPECT_EQ(minta::SinkCounters::bucketFor(~uint64_t(0)), minta::SinkCounters::LatencyBuckets - 1u);
+}
+
+TEST_F(LogStatsTest, EmitsPeriodicStatsEntries) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger);
+    logger.info("Before stats");
+    logger.setStatsInterval(std::chrono::milliseconds(20));
+
+    ASSERT_TRUE(memory->waitFor(3));
+    logger.setStatsInterval(std::chrono::milliseconds(0));
+    std::vector<std::string> records = memory->drain();
+    EXPECT_NE(records[0].find("Before stats"), std::string::npos);
+    EXPECT_NE(records[1].find("[INFO] LunarLog stats: enqueued=1 dropped_rate_limited=0 dropped_overflow=0"),
+              std::string::npos) << records[1];
+    EXPECT_NE(records[2].find("LunarLog stats:"), std::string::npos);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+
+class LogfmtFormatterTest : public ::testing::Test {
+protected:
+    void SetUp() override { TestUtils::cleanupLogFiles(); }
+    void TearDown() override { TestUtils::cleanupLogFiles(); }
+
+    static minta::LogEntry makeEntry() {
+        minta::LogEntry entry;
+        entry.level = minta::LogLevel::WARN;
+        entry.message = "User alice failed login";
+        entry.templateStr = "User {username} failed login";
+        entry.arguments = {{"username", "alice"}};
+        entry.timestamp = std::chrono::system_clock::now();
+        entry.line = 0;
+        entry.customContext = {{"host", "db 1"}};
+        return entry;
+    }
+};
+
+TEST_F(LogfmtFormatterTest, WritesKeyValuePairs) {
+    minta::LogfmtFormatter formatter;
+    std::string line = formatter.format(makeEntry());
+
+    EXPECT_EQ(line.compare(0, 3, "ts="), 0);
+    EXPECT_NE(line.find(" level=warn msg=\"User alice failed login\" username=alice host=\"db 1\""), std::string::npos);
+    EXPECT_EQ(line.find('\n'), std::string::npos);
+}
+
+TEST_F(LogfmtFormatterTest, IncludesSourceLocation) {
+    minta::LogEntry entry = makeEntry();
+    entry.file = "main.cpp";
+    entry.line = 12;
+    entry.function = "run";
+
+    minta::LogfmtFormatter formatter;
+    EXPECT_NE(formatter.format(entry).find(" file=main.cpp line=12 func=run "), std::string::npos);
+}
+
+TEST_F(LogfmtFormatterTest, EscapesQuotedValues) {
+    minta::LogEntry entry = makeEntry();
+    entry.message = "say \"hi\"\\now\n";
+    entry.arguments = {{"empty", ""}, {"bad key", "a=b"}};
+    entry.customContext.clear();
+
+    minta::LogfmtFormatter formatter;
+    std::string line = formatter.format(entry);
+    EXPECT_NE(line.find(R"(msg="say \"hi\"\\now\n" empty="" bad_key="a=b")"), std::string::npos);
+}
+
+TEST_F(LogfmtFormatterTest, QuotingScanMatchesBytewiseCheck) {
+    const std::string special = " \t\n\"=\\\x7f\x01";
+    for (size_t length = 1; length <= 24; ++length) {
+        std::string plain(length, 'a');
+        EXPECT_FALSE(minta::LogfmtFormatter::needsQuoting(plain));
+        EXPECT_FALSE(minta::LogfmtFormatter::needsQuoting(plain + "\xc3\xa9"));
+
+        for (size_t pos = 0; pos < length; ++pos) {
+            for (char c : special) {
+                std::string value = plain;
+                value[pos] = c;
+                EXPECT_TRUE(minta::LogfmtFormatter::needsQuoting(value)) << "length " << length << " pos " << pos;
+            }
+        }
+    }
+    EXPECT_TRUE(minta::LogfmtFormatter::needsQuoting(""));
+}
+
+TEST_F(LogfmtFormatterTest, UsableAsSinkFormatter) {
+    minta::LunarLog logger(minta::LogLevel::INFO);
+    logger.addSink<minta::FileSink, minta::LogfmtFormatter>("test_log.txt");
+
+    logger.info("Order {id} shipped", 42);
+
+    TestUtils::waitForFileContent("test_log.txt");
+    std::string logContent = TestUtils::readLogFile("test_log.txt");
+    EXPECT_NE(logContent.find("level=info msg=\"Order 42 shipped\" id=42"), std::string::npos);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+#include <thread>
+
+class MemorySinkTest : public ::testing::Test {
+};
+
+TEST_F(MemorySinkTest, CollectsFormattedRecords) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger);
+
+    for (int i = 0; i < 100; ++i) {
+        logger.info("Message {index}", i);
+    }
+
+    ASSERT_TRUE(memory->waitFor(100));
+    std::vector<std::string> records = memory->drain();
+    ASSERT_EQ(records.size(), 100u);
+    EXPECT_NE(records.front().find("[INFO] Message 0"), std::string::npos);
+    EXPECT_NE(records.back().find("[INFO] Message 99"), std::string::npos);
+    EXPECT_EQ(memory->dropped(), 0u);
+}
+
+TEST_F(MemorySinkTest, UsesConfiguredFormatter) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger);
+    memory->setFormatter(std::make_shared<minta::JsonFormatter>());
+
+    logger.warn("Disk {percent} full", 91);
+
+    ASSERT_TRUE(memory->waitFor(1));
+    std::string record;
+    ASSERT_TRUE(memory->pop(record));
+    EXPECT_NE(record.find(R"("level":"WARN")"), std::string::npos);
+    EXPECT_NE(record.find(R"("message":"Disk 91 full")"), std::string::npos);
+}
+
+TEST_F(MemorySinkTest, DropsWhenFullAndReusesSlots) {
+    minta::MemorySink sink(8);
+    minta::LogEntry entry;
+    for (int i = 0; i < 20; ++i) {
+        sink.writeFormatted(entry, "record " + std::to_string(i));
+    }
+    EXPECT_EQ(sink.written(), 8u);
+    EXPECT_EQ(sink.dropped(), 12u);
+
+    std::string record;
+    ASSERT_TRUE(sink.pop(record));
+    EXPECT_EQ(record, "record 0");
+    sink.writeFormatted(entry, "record 20");
+
+    std::vector<std::string> rest = sink.drain();
+    ASSERT_EQ(rest.size(), 8u);
+    EXPECT_EQ(rest.front(), "record 1");
+    EXPECT_EQ(rest.back(), "record 20");
+    EXPECT_FALSE(sink.pop(record));
+}
+
+TEST_F(MemorySinkTest, ReaderRunsConcurrentlyWithWorker) {
+    const int count = 20000;
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    logger.setRateLimit(0);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger, nullptr, minta::LogLevel::TRACE, 64);
+
+    std::vector<std::string> received;
+    std::thread reader([&] {
+        std::string record;
+        while (received.size() + memory->dropped() < static_cast<size_t>(count)) {
+            if (memory->pop(record)) {
+                received.push_back(record);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (int i = 0; i < count; ++i) {
+        logger.info("Message {index}", i);
+    }
+    reader.join();
+
+    EXPECT_EQ(received.size() + memory->dropped(), static_cast<size_t>(count));
+    int last = -1;
+    for (const auto &record : received) {
+        int index = std::stoi(record.substr(record.find("Message ") + 8));
+        EXPECT_GT(index, last);
+        last = index;
+    }
+}
+
+TEST_F(MemorySinkTest, WaitForTimesOut) {
+    minta::MemorySink sink;
+    EXPECT_FALSE(sink.waitFor(1, std::chrono::milliseconds(10)));
+}
+
+TEST_F(MemorySinkTest, NullSinkCountsOutput) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    auto sink = minta::make_unique<minta::NullSink>();
+    const minta::NullTransport &transport = sink->transport();
+    logger.addCustomSink(std::move(sink));
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger);
+
+    logger.info("First");
+    logger.info("Second");
+    ASSERT_TRUE(memory->waitFor(2));
+
+    std::vector<std::string> records = memory->drain();
+    EXPECT_EQ(transport.writes(), 2u);
+    EXPECT_EQ(transport.bytesWritten(), records[0].size() + records[1].size());
+}
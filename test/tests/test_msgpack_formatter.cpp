@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+#include <cstdint>
+
+namespace {
+    // Minimal MessagePack reader covering the subset MsgPackFormatter emits,
+    // rendering values as compact JSON-like text for comparison.
+    class MsgPackText {
+    public:
+        explicit MsgPackText(const std::string &data) : m_data(data), m_pos(0) {}
+
+        std::string next() {
+            uint8_t byte = take();
+            if (byte <= 0x7f) return std::to_string(byte);
+            if (byte >= 0xe0) return std::to_string(static_cast<int>(byte) - 256);
+            if ((byte & 0xf0) == 0x80) return map(byte & 0x0f);
+            if ((byte & 0xe0) == 0xa0) return str(byte & 0x1f);
+            switch (byte) {
+                case 0xd9: return str(bigEndian(1));
+                case 0xda: return str(bigEndian(2));
+                case 0xde: return map(bigEndian(2));
+                case 0xd3: return std::to_string(static_cast<int64_t>(bigEndian(8)));
+                case 0xd7: {
+                    take();
+                    uint64_t raw = bigEndian(8);
+                    return "ts(" + std::to_string(raw & 0x3ffffffffULL) + "." + std::to_string(raw >> 34) + ")";
+                }
+                default: return "?";
+            }
+        }
+
+        bool atEnd() const { return m_pos == m_data.size(); }
+
+    private:
+        const std::string &m_data;
+        size_t m_pos;
+
+        uint8_t take() { return static_cast<uint8_t>(m_data.at(m_pos++)); }
+
+        uint64_t bigEndian(int bytes) {
+            uint64_t value = 0;
+            for (int i = 0; i < bytes; ++i) value = (value << 8) | take();
+            return value;
+        }
+
+        std::string str(size_t size) {
+            std::string value = m_data.substr(m_pos, size);
+            m_pos += size;
+            return "\"" + value + "\"";
+        }
+
+        std::string map(size_t size) {
+            std::string text = "{";
+            for (size_t i = 0; i < size; ++i) {
+                if (i) text += ",";
+                text += next();
+                text += ":";
+                text += next();
+            }
+            return text + "}";
+        }
+    };
+
+    minta::LogEntry makeEntry() {
+        minta::LogEntry entry;
+        entry.level = minta::LogLevel::INFO;
+        entry.message = "User alice logged in";
+        entry.templateStr = "User {username} logged in";
+        entry.arguments = {{"username", "alice"}};
+        entry.timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000)) +
+                          std::chrono::nanoseconds(250);
+        entry.line = 0;
+        return entry;
+    }
+}
+
+class MsgPackFormatterTest : public ::testing::Test {
+protected:
+    void SetUp() override { TestUtils::cleanupLogFiles(); }
+    void TearDown() override { TestUtils::cleanupLogFiles(); }
+};
+
+TEST_F(MsgPackFormatterTest, EncodesEntryAsMap) {
+    minta::MsgPackFormatter formatter;
+    std::string data = formatter.format(makeEntry());
+
+    MsgPackText reader(data);
+    EXPECT_EQ(reader.next(),
+              R"({"level":"INFO","timestamp":ts(1700000000.250),"template":"User {username} logged in",)"
+              R"("message":"User alice logged in","properties":{"username":"alice"}})");
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST_F(MsgPackFormatterTest, EncodesSourceAndContext) {
+    minta::LogEntry entry = makeEntry();
+    entry.file = "main.cpp";
+    entry.line = 300;
+    entry.function = "run";
+    entry.customContext = {{"session_id", "abc123"}};
+    entry.message = std::string(40, 'x');
+
+    minta::MsgPackFormatter formatter;
+    std::string data = formatter.format(entry);
+
+    MsgPackText reader(data);
+    std::string text = reader.next();
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_NE(text.find(R"("message":")" + std::string(40, 'x') + "\""), std::string::npos);
+    EXPECT_NE(text.find(R"("file":"main.cpp","line":300,"function":"run")"), std::string::npos);
+    EXPECT_NE(text.find(R"("context":{"session_id":"abc123"})"), std::string::npos);
+}
+
+TEST_F(MsgPackFormatterTest, StreamsThroughBinaryFileTransport) {
+    {
+        minta::LunarLog logger(minta::LogLevel::INFO);
+        auto sink = minta::make_unique<minta::StaticSink<minta::MsgPackFormatter, minta::BinaryFileTransport> >("msgpack_log.bin");
+        logger.addCustomSink(std::move(sink));
+        logger.info("First {n}", 1);
+        logger.info("Second {n}", 2);
+    }
+
+    std::string data = TestUtils::readLogFile("msgpack_log.bin");
+    MsgPackText reader(data);
+    EXPECT_NE(reader.next().find(R"("message":"First 1")"), std::string::npos);
+    EXPECT_NE(reader.next().find(R"("message":"Second 2")"), std::string::npos);
+    EXPECT_TRUE(reader.atEnd());
+}
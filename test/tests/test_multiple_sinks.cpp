@@ -38,4 +38,39 @@ TEST_F(MultipleSinksTest, DifferentFormattersForDifferentSinks) {
 
     EXPECT_TRUE(logContent1.find("Test message for multiple formatters") != std::string::npos);
     EXPECT_TRUE(logContent2.find("\"message\":\"Test message for multiple formatters\"") != std::string::npos);
-}
\ No newline at end of file
+}
+
+class CountingFormatter : public minta::IFormatter {
+public:
+    CountingFormatter() : m_calls(0) {}
+
+    bool isStateless() const override { return true; }
+
+    std::string format(const minta::LogEntry &entry) const override {
+        ++m_calls;
+        return "COUNTED: " + entry.message;
+    }
+
+    int calls() const { return m_calls; }
+
+private:
+    mutable std::atomic<int> m_calls;
+};
+
+TEST_F(MultipleSinksTest, SharedFormatterFormatsOncePerEntry) {
+    auto formatter = std::make_shared<CountingFormatter>();
+    {
+        minta::LunarLog logger(minta::LogLevel::INFO);
+        logger.addSinkWithFormatter<minta::FileSink>(formatter, "test_log1.txt");
+        logger.addSinkWithFormatter<minta::FileSink>(formatter, "test_log2.txt");
+
+        logger.info("Shared formatter message");
+
+        TestUtils::waitForFileContent("test_log1.txt");
+        TestUtils::waitForFileContent("test_log2.txt");
+    }
+
+    EXPECT_EQ(formatter->calls(), 1);
+    EXPECT_TRUE(TestUtils::readLogFile("test_log1.txt").find("COUNTED: Shared formatter message") != std::string::npos);
+    EXPECT_TRUE(TestUtils::readLogFile("test_log2.txt").find("COUNTED: Shared formatter message") != std::string::npos);
+}
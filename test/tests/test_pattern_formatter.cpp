@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+#include <ctime>
+
+class PatternFormatterTest : public ::testing::Test {
+protected:
+    void SetUp() override { TestUtils::cleanupLogFiles(); }
+    void TearDown() override { TestUtils::cleanupLogFiles(); }
+
+    static minta::LogEntry makeEntry() {
+        std::tm local = std::tm();
+        local.tm_year = 2024 - 1900;
+        local.tm_mon = 2;
+        local.tm_mday = 7;
+        local.tm_hour = 14;
+        local.tm_min = 3;
+        local.tm_sec = 9;
+        local.tm_isdst = -1;
+
+        minta::LogEntry entry;
+        entry.level = minta::LogLevel::WARN;
+        entry.message = "Disk almost full";
+        entry.timestamp = std::chrono::system_clock::from_time_t(std::mktime(&local)) + std::chrono::microseconds(123456);
+        entry.templateStr = "Disk almost {state}";
+        entry.file = "main.cpp";
+        entry.line = 42;
+        entry.function = "run";
+        entry.customContext = {{"host", "db1"}, {"region", "eu"}};
+        return entry;
+    }
+};
+
+TEST_F(PatternFormatterTest, RendersAllFields) {
+    minta::PatternFormatter formatter("%Y-%m-%dT%H:%M:%S.%f %l %L %s:%# %! %v | %T %ctx");
+    EXPECT_EQ(formatter.format(makeEntry()),
+              "2024-03-07T14:03:09.123456 WARN W main.cpp:42 run Disk almost full | Disk almost {state} {host=db1, region=eu}");
+}
+
+TEST_F(PatternFormatterTest, SubsecondPrecisions) {
+    minta::PatternFormatter formatter("%e|%f|%F");
+    EXPECT_EQ(formatter.format(makeEntry()), "123|123456|123456000");
+}
+
+TEST_F(PatternFormatterTest, PaddingAndTruncation) {
+    minta::PatternFormatter formatter("[%-5l][%7l][%.4v][%-6.3v]");
+    EXPECT_EQ(formatter.format(makeEntry()), "[WARN ][   WARN][Disk][Dis   ]");
+}
+
+TEST_F(PatternFormatterTest, LiteralPercentAndUnknownFields) {
+    minta::PatternFormatter formatter("100%% %q %v%");
+    EXPECT_EQ(formatter.format(makeEntry()), "100% %q Disk almost full%");
+}
+
+TEST_F(PatternFormatterTest, EmptyContextRendersNothing) {
+    minta::LogEntry entry = makeEntry();
+    entry.customContext.clear();
+    minta::PatternFormatter formatter("%v%ctx");
+    EXPECT_EQ(formatter.format(entry), "Disk almost full");
+}
+
+TEST_F(PatternFormatterTest, UsableAsSinkFormatter) {
+    minta::LunarLog logger(minta::LogLevel::INFO);
+    logger.addSinkWithFormatter<minta::FileSink>(std::make_shared<minta::PatternFormatter>("%L [%t] %v"), "test_log.txt");
+
+    logger.info("User {username} logged in", "alice");
+
+    TestUtils::waitForFileContent("test_log.txt");
+    std::string logContent = TestUtils::readLogFile("test_log.txt");
+    EXPECT_EQ(logContent.compare(0, 3, "I ["), 0);
+    EXPECT_TRUE(logContent.find("] User alice logged in") != std::string::npos);
+}
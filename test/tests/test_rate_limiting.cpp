@@ -41,4 +41,37 @@ TEST_F(RateLimitingTest, ResetAfterRateLimit) {
     std::string logContent = TestUtils::readLogFile("rate_limit_test_log.txt");
 
     EXPECT_TRUE(logContent.find("This message should appear after the rate limit reset") != std::string::npos);
+}
+
+TEST_F(RateLimitingTest, ConfigurableRateLimit) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    logger.setRateLimit(100);
+    EXPECT_EQ(logger.getRateLimit(), 100u);
+    logger.addSink<minta::FileSink>("rate_limit_test_log.txt");
+
+    for (int i = 0; i < 150; ++i) {
+        logger.info("Message {index}", i);
+    }
+
+    TestUtils::waitForFileContent("rate_limit_test_log.txt");
+    std::string logContent = TestUtils::readLogFile("rate_limit_test_log.txt");
+
+    size_t messageCount = std::count(logContent.begin(), logContent.end(), '\n');
+    EXPECT_EQ(messageCount, 100);
+}
+
+TEST_F(RateLimitingTest, DisableRateLimit) {
+    {
+        minta::LunarLog logger(minta::LogLevel::INFO, false);
+        logger.setRateLimit(0);
+        logger.addSink<minta::FileSink>("rate_limit_test_log.txt");
+
+        for (int i = 0; i < 1500; ++i) {
+            logger.info("Message {index}", i);
+        }
+    }
+
+    std::string logContent = TestUtils::readLogFile("rate_limit_test_log.txt");
+    size_t messageCount = std::count(logContent.begin(), logContent.end(), '\n');
+    EXPECT_EQ(messageCount, 1500);
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+
+class RoutingTest : public ::testing::Test {
+protected:
+    static size_t count(minta::LogManager &manager, const std::string &tag, minta::LogLevel level) {
+        std::shared_ptr<const minta::LogManager::Snapshot> sinks = manager.snapshot();
+        const uint64_t *route = sinks->routes.route(tag, level);
+        size_t total = 0;
+        for (size_t word = 0; word < sinks->routes.words; ++word) {
+            for (uint64_t bits = route[word]; bits != 0; bits &= bits - 1) {
+                ++total;
+            }
+        }
+        return total;
+    }
+};
+
+TEST_F(RoutingTest, RoutesByLevelAndTag) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    minta::SinkId everythingId;
+    minta::SinkId errorsId;
+    minta::SinkId auditId;
+    minta::MemorySink *everything = TestUtils::addMemorySink(logger, &everythingId);
+    minta::MemorySink *errors = TestUtils::addMemorySink(logger, &errorsId);
+    minta::MemorySink *audit = TestUtils::addMemorySink(logger, &auditId);
+    logger.setSinkMinLevel(errorsId, minta::LogLevel::ERROR);
+    EXPECT_TRUE(logger.setSinkTags(auditId, {"audit", "security"}));
+    EXPECT_FALSE(logger.setSinkTags(auditId + 100, {"audit"}));
+
+    logger.info("plain info");
+    logger.error("plain error");
+    logger.logTagged("audit", minta::LogLevel::INFO, "User {name} signed in", "alice");
+    logger.logTagged("security", minta::LogLevel::ERROR, "Token rejected");
+    logger.logTagged("billing", minta::LogLevel::INFO, "Invoice sent");
+
+    ASSERT_TRUE(everything->waitFor(5));
+    ASSERT_TRUE(errors->waitFor(2));
+    ASSERT_TRUE(audit->waitFor(2));
+    std::vector<std::string> errorRecords = errors->drain();
+    std::vector<std::string> auditRecords = audit->drain();
+    ASSERT_EQ(errorRecords.size(), 2u);
+    EXPECT_NE(errorRecords[0].find("plain error"), std::string::npos);
+    EXPECT_NE(errorRecords[1].find("Token rejected"), std::string::npos);
+    ASSERT_EQ(auditRecords.size(), 2u);
+    EXPECT_NE(auditRecords[0].find("User alice signed in"), std::string::npos);
+    EXPECT_NE(auditRecords[1].find("Token rejected"), std::string::npos);
+    EXPECT_EQ(everything->drain().size(), 5u);
+}
+
+TEST_F(RoutingTest, TableTracksSinkChanges) {
+    minta::LogManager manager;
+    minta::SinkId first = manager.addSink(minta::make_unique<minta::NullSink>());
+    minta::SinkId second = manager.addSink(minta::make_unique<minta::NullSink>());
+    EXPECT_EQ(count(manager, "", minta::LogLevel::TRACE), 2u);
+
+    manager.setSinkMinLevel(first, minta::LogLevel::WARN);
+    EXPECT_EQ(count(manager, "", minta::LogLevel::INFO), 1u);
+    EXPECT_EQ(count(manager, "", minta::LogLevel::WARN), 2u);
+
+    manager.setSinkTags(second, {"audit"});
+    EXPECT_EQ(count(manager, "", minta::LogLevel::INFO), 0u);
+    EXPECT_EQ(count(manager, "audit", minta::LogLevel::INFO), 1u);
+    EXPECT_EQ(count(manager, "other", minta::LogLevel::ERROR), 1u);
+
+    manager.setSinkTags(second, {});
+    manager.removeSink(first);
+    EXPECT_EQ(count(manager, "audit", minta::LogLevel::TRACE), 1u);
+}
+
+TEST_F(RoutingTest, MoreThanSixtyFourSinks) {
+    minta::LogManager manager;
+    std::vector<minta::SinkId> ids;
+    for (int i = 0; i < 70; ++i) {
+        ids.push_back(manager.addSink(minta::make_unique<minta::NullSink>()));
+    }
+    manager.setSinkMinLevel(ids[3], minta::LogLevel::ERROR);
+    manager.setSinkTags(ids[68], {"audit"});
+    EXPECT_EQ(count(manager, "", minta::LogLevel::INFO), 68u);
+    EXPECT_EQ(count(manager, "audit", minta::LogLevel::INFO), 69u);
+
+    minta::LogEntry entry;
+    entry.level = minta::LogLevel::INFO;
+    entry.message = "fan-out";
+    entry.line = 0;
+    entry.tag = "audit";
+    manager.log(entry);
+    std::vector<minta::SinkStats> stats = manager.sinkStats();
+    EXPECT_EQ(stats[3].entries, 0u);
+    EXPECT_EQ(stats[68].entries, 1u);
+    EXPECT_EQ(stats[69].entries, 1u);
+}
+
+TEST_F(RoutingTest, FilterOnTag) {
+    minta::LogEntry entry;
+    entry.level = minta::LogLevel::INFO;
+    entry.line = 0;
+    entry.tag = "audit";
+    EXPECT_TRUE(minta::LogFilter("tag == audit").matches(entry));
+    EXPECT_FALSE(minta::LogFilter("tag ~ \"bill*\"").matches(entry));
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+#include <atomic>
+
+namespace {
+    class CountingFormatter : public minta::IFormatter {
+    public:
+        explicit CountingFormatter(std::atomic<int> &calls) : m_calls(calls) {
+        }
+
+        std::string format(const minta::LogEntry &entry) const override {
+            ++m_calls;
+            return entry.message;
+        }
+
+    private:
+        std::atomic<int> &m_calls;
+    };
+}
+
+class SinkLevelsTest : public ::testing::Test {
+};
+
+TEST_F(SinkLevelsTest, EachSinkReceivesEntriesAtOrAboveItsLevel) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    minta::SinkId debugId;
+    minta::SinkId errorId;
+    minta::MemorySink *debugSink = TestUtils::addMemorySink(logger, &debugId);
+    minta::MemorySink *errorSink = TestUtils::addMemorySink(logger, &errorId);
+    ASSERT_NE(debugId, errorId);
+    EXPECT_TRUE(logger.setSinkMinLevel(debugId, minta::LogLevel::DEBUG));
+    EXPECT_TRUE(logger.setSinkMinLevel(errorId, minta::LogLevel::ERROR));
+
+    logger.trace("trace message");
+    logger.debug("debug message");
+    logger.info("info message");
+    logger.error("error message");
+
+    ASSERT_TRUE(debugSink->waitFor(3));
+    ASSERT_TRUE(errorSink->waitFor(1));
+    std::vector<std::string> debugRecords = debugSink->drain();
+    std::vector<std::string> errorRecords = errorSink->drain();
+    ASSERT_EQ(debugRecords.size(), 3u);
+    EXPECT_NE(debugRecords[0].find("debug message"), std::string::npos);
+    ASSERT_EQ(errorRecords.size(), 1u);
+    EXPECT_NE(errorRecords[0].find("error message"), std::string::npos);
+
+    minta::LogLevel level;
+    ASSERT_TRUE(logger.getSinkMinLevel(errorId, level));
+    EXPECT_EQ(level, minta::LogLevel::ERROR);
+}
+
+TEST_F(SinkLevelsTest, FormatsOnlyForSinksThatAcceptTheEntry) {
+    std::atomic<int> errorFormats(0);
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    minta::SinkId infoId;
+    minta::MemorySink *infoSink = TestUtils::addMemorySink(logger, &infoId);
+    auto errorSink = minta::make_unique<minta::MemorySink>(256);
+    errorSink->setFormatter(std::make_shared<CountingFormatter>(errorFormats));
+    minta::MemorySink *errorMemory = errorSink.get();
+    minta::SinkId errorId = logger.addCustomSink(std::move(errorSink));
+    logger.setSinkMinLevel(errorId, minta::LogLevel::ERROR);
+
+    for (int i = 0; i < 10; ++i) {
+        logger.info("info {index}", i);
+    }
+    logger.error("failure");
+
+    ASSERT_TRUE(infoSink->waitFor(11));
+    ASSERT_TRUE(errorMemory->waitFor(1));
+    EXPECT_EQ(errorFormats.load(), 1);
+}
+
+TEST_F(SinkLevelsTest, GlobalGateFollowsTheLowestSinkLevel) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    minta::SinkId warnId;
+    minta::SinkId errorId;
+    TestUtils::addMemorySink(logger, &warnId);
+    TestUtils::addMemorySink(logger, &errorId);
+    logger.setSinkMinLevel(warnId, minta::LogLevel::WARN);
+    logger.setSinkMinLevel(errorId, minta::LogLevel::ERROR);
+
+    logger.debug("dropped before the queue");
+    logger.info("dropped before the queue");
+    EXPECT_EQ(logger.getStats().enqueued, 0u);
+
+    logger.warn("accepted");
+    EXPECT_EQ(logger.getStats().enqueued, 1u);
+
+    logger.setSinkMinLevel(warnId, minta::LogLevel::DEBUG);
+    logger.debug("accepted now");
+    EXPECT_EQ(logger.getStats().enqueued, 2u);
+}
+
+TEST_F(SinkLevelsTest, LoggerLevelStillApplies) {
+    minta::LunarLog logger(minta::LogLevel::ERROR, false);
+    minta::SinkId id;
+    TestUtils::addMemorySink(logger, &id);
+
+    logger.warn("below the logger level");
+    EXPECT_EQ(logger.getStats().enqueued, 0u);
+
+    logger.setMinLevel(minta::LogLevel::TRACE);
+    logger.setSinkMinLevel(id, minta::LogLevel::WARN);
+    logger.info("below the sink level");
+    logger.warn("accepted");
+    EXPECT_EQ(logger.getStats().enqueued, 1u);
+}
+
+TEST_F(SinkLevelsTest, UnknownSinkId) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    minta::LogLevel level;
+    EXPECT_FALSE(logger.setSinkMinLevel(42, minta::LogLevel::ERROR));
+    EXPECT_FALSE(logger.getSinkMinLevel(42, level));
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+#include <atomic>
+#include <thread>
+
+class SinkSnapshotsTest : public ::testing::Test {
+};
+
+TEST_F(SinkSnapshotsTest, RemovedSinkStopsReceivingEntries) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    minta::SinkId keptId;
+    minta::SinkId removedId;
+    minta::MemorySink *kept = TestUtils::addMemorySink(logger, &keptId);
+    TestUtils::addMemorySink(logger, &removedId);
+
+    logger.info("before");
+    ASSERT_TRUE(kept->waitFor(1));
+    EXPECT_TRUE(logger.removeSink(removedId));
+    EXPECT_FALSE(logger.removeSink(removedId));
+
+    logger.info("after");
+    ASSERT_TRUE(kept->waitFor(2));
+    minta::LogStats stats = logger.getStats();
+    ASSERT_EQ(stats.sinks.size(), 1u);
+    EXPECT_EQ(stats.sinks[0].id, keptId);
+    EXPECT_EQ(stats.sinks[0].entries, 2u);
+}
+
+TEST_F(SinkSnapshotsTest, ReplacedSinkKeepsIdLevelAndStats) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    minta::SinkId id;
+    minta::MemorySink *original = TestUtils::addMemorySink(logger, &id);
+    logger.setSinkMinLevel(id, minta::LogLevel::WARN);
+
+    logger.warn("to the original");
+    ASSERT_TRUE(original->waitFor(1));
+
+    auto sink = minta::make_unique<minta::MemorySink>(16);
+    minta::MemorySink *replacement = sink.get();
+    EXPECT_TRUE(logger.replaceSink(id, std::move(sink)));
+    EXPECT_FALSE(logger.replaceSink(id + 1, minta::make_unique<minta::MemorySink>(16)));
+
+    logger.info("below the kept level");
+    logger.error("to the replacement");
+    ASSERT_TRUE(replacement->waitFor(1));
+    std::vector<std::string> records = replacement->drain();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_NE(records[0].find("to the replacement"), std::string::npos);
+
+    minta::LogStats stats = logger.getStats();
+    ASSERT_EQ(stats.sinks.size(), 1u);
+    EXPECT_EQ(stats.sinks[0].id, id);
+    EXPECT_EQ(stats.sinks[0].entries, 2u);
+}
+
+TEST_F(SinkSnapshotsTest, RemovingTheLowestLevelSinkRaisesTheGate) {
+    minta::LunarLog logger(minta::LogLevel::TRACE, false);
+    minta::SinkId debugId;
+    minta::SinkId errorId;
+    TestUtils::addMemorySink(logger, &debugId);
+    TestUtils::addMemorySink(logger, &errorId);
+    logger.setSinkMinLevel(debugId, minta::LogLevel::DEBUG);
+    logger.setSinkMinLevel(errorId, minta::LogLevel::ERROR);
+
+    logger.debug("accepted");
+    EXPECT_EQ(logger.getStats().enqueued, 1u);
+    logger.removeSink(debugId);
+    logger.warn("dropped before the queue");
+    EXPECT_EQ(logger.getStats().enqueued, 1u);
+}
+
+TEST_F(SinkSnapshotsTest, SinksChangeWhileProducersLog) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    logger.setRateLimit(0);
+    minta::SinkId stableId;
+    minta::MemorySink *stable = TestUtils::addMemorySink(logger, &stableId, minta::LogLevel::TRACE, 1 << 16);
+
+    const int perThread = 5000;
+    std::atomic<bool> producing(true);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 2; ++t) {
+        producers.emplace_back([&logger, t] {
+            for (int i = 0; i < perThread; ++i) {
+                logger.info("Producer {thread} message {index}", t, i);
+            }
+        });
+    }
+    std::thread churn([&] {
+        while (producing) {
+            minta::SinkId id = logger.addSink<minta::NullSink>();
+            logger.setSinkMinLevel(id, minta::LogLevel::WARN);
+            logger.replaceSink(id, minta::make_unique<minta::NullSink>());
+            logger.removeSink(id);
+        }
+    });
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    producing = false;
+    churn.join();
+
+    ASSERT_TRUE(stable->waitFor(2 * perThread));
+    EXPECT_EQ(stable->drain().size(), static_cast<size_t>(2 * perThread));
+    EXPECT_EQ(logger.getStats().sinks.size(), 1u);
+}
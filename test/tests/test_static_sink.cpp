@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+
+class StaticSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override { TestUtils::cleanupLogFiles(); }
+    void TearDown() override { TestUtils::cleanupLogFiles(); }
+};
+
+TEST_F(StaticSinkTest, WritesAlongsideDynamicSinks) {
+    minta::LunarLog logger(minta::LogLevel::INFO);
+    logger.addCustomSink(minta::make_unique<minta::StaticSink<minta::JsonFormatter, minta::FileTransport> >("static_sink_log.txt"));
+    logger.addSink<minta::FileSink>("test_log.txt");
+
+    logger.info("User {username} logged in", "alice");
+
+    TestUtils::waitForFileContent("static_sink_log.txt");
+    TestUtils::waitForFileContent("test_log.txt");
+    std::string staticContent = TestUtils::readLogFile("static_sink_log.txt");
+    std::string dynamicContent = TestUtils::readLogFile("test_log.txt");
+
+    EXPECT_TRUE(staticContent.find("\"level\":\"INFO\"") != std::string::npos);
+    EXPECT_TRUE(staticContent.find("\"message\":\"User alice logged in\"") != std::string::npos);
+    EXPECT_TRUE(dynamicContent.find("[INFO] User alice logged in") != std::string::npos);
+}
+
+TEST_F(StaticSinkTest, JsonFormatToAppendsFormatOutput) {
+    minta::LogEntry entry;
+    entry.level = minta::LogLevel::WARN;
+    entry.message = "Quote \" and tab \t";
+    entry.timestamp = std::chrono::system_clock::now();
+    entry.line = 0;
+    entry.customContext = {{"k", "v"}};
+
+    minta::JsonFormatter formatter;
+    std::string appended = "prefix:";
+    formatter.formatTo(entry, appended);
+
+    EXPECT_EQ(appended, "prefix:" + formatter.format(entry));
+    EXPECT_TRUE(appended.find(R"("message":"Quote \" and tab \t")") != std::string::npos);
+    EXPECT_TRUE(appended.find(R"("context":{"k":"v"}})") != std::string::npos);
+}
+
+TEST_F(StaticSinkTest, WritesSameBytesAsFileSink) {
+    minta::LogEntry entry;
+    entry.level = minta::LogLevel::ERROR;
+    entry.message = "Payment 42 failed";
+    entry.templateStr = "Payment {id} failed";
+    entry.arguments = {{"id", "42"}};
+    entry.timestamp = std::chrono::system_clock::now();
+    entry.file = "pay.cpp";
+    entry.line = 12;
+    entry.function = "charge";
+    entry.customContext = {{"tenant", "acme"}};
+    {
+        minta::StaticSink<minta::JsonFormatter, minta::FileTransport> staticSink("static_sink_log.txt");
+        minta::FileSink fileSink("test_log.txt");
+        fileSink.setFormatter(std::make_shared<minta::JsonFormatter>());
+        for (int i = 0; i < 2; ++i) {
+            staticSink.write(entry);
+            fileSink.write(entry);
+        }
+    }
+
+    std::string staticContent = TestUtils::readLogFile("static_sink_log.txt");
+    EXPECT_FALSE(staticContent.empty());
+    EXPECT_EQ(staticContent, TestUtils::readLogFile("test_log.txt"));
+}
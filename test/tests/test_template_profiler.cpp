@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "lunar_log.hpp"
+#include "utils/test_utils.hpp"
+#include <thread>
+
+class TemplateProfilerTest : public ::testing::Test {
+};
+
+TEST_F(TemplateProfilerTest, AggregatesPerTemplate) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger);
+    logger.setProfiling(true);
+
+    for (int i = 0; i < 30; ++i) {
+        logger.info("Cache miss for {key}", i);
+    }
+    for (int i = 0; i < 10; ++i) {
+        logger.warn("Slow query took {ms} ms", i * 100);
+    }
+    ASSERT_TRUE(memory->waitFor(40));
+
+    size_t cacheBytes = 0;
+    for (const auto &record : memory->drain()) {
+        if (record.find("Cache miss") != std::string::npos) cacheBytes += record.size();
+    }
+
+    std::vector<minta::TemplateProfile> profiles = logger.getProfile(minta::ProfileOrder::Calls);
+    ASSERT_EQ(profiles.size(), 2u);
+    EXPECT_EQ(profiles[0].templateStr, "Cache miss for {key}");
+    EXPECT_EQ(profiles[0].calls, 30u);
+    EXPECT_EQ(profiles[0].bytes, cacheBytes);
+    EXPECT_GT(profiles[0].callerNanos, 0u);
+    EXPECT_GT(profiles[0].workerNanos, 0u);
+    EXPECT_EQ(profiles[1].templateStr, "Slow query took {ms} ms");
+    EXPECT_EQ(profiles[1].calls, 10u);
+
+    std::string report = logger.profileReport();
+    EXPECT_NE(report.find("Cache miss for {key}"), std::string::npos);
+    EXPECT_LT(report.find("template"), report.find("{key}"));
+
+    logger.resetProfile();
+    EXPECT_TRUE(logger.getProfile().empty());
+}
+
+TEST_F(TemplateProfilerTest, DisabledByDefault) {
+    minta::LunarLog logger(minta::LogLevel::INFO, false);
+    minta::MemorySink *memory = TestUtils::addMemorySink(logger);
+    EXPECT_FALSE(logger.getProfiling());
+
+    logger.info("Not profiled");
+    ASSERT_TRUE(memory->waitFor(1));
+    EXPECT_TRUE(logger.getProfile().empty());
+}
+
+TEST_F(TemplateProfilerTest, MergesShardsAndSorts) {
+    minta::TemplateProfiler profiler;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&profiler] {
+            for (int i = 0; i < 100; ++i) {
+                profiler.recordCall("hot {x}", 10);
+                profiler.recordCall("cold {x}", 1);
+            }
+            profiler.recordWrite("bulky {x}", 100000, 5);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<minta::TemplateProfile> byTime = profiler.report();
+    ASSERT_EQ(byTime.size(), 3u);
+    EXPECT_EQ(byTime[0].templateStr, "hot {x}");
+    EXPECT_EQ(byTime[0].calls, 400u);
+    EXPECT_EQ(byTime[0].callerNanos, 4000u);
+
+    std::vector<minta::TemplateProfile> byBytes = profiler.report(minta::ProfileOrder::Bytes);
+    EXPECT_EQ(byBytes[0].templateStr, "bulky {x}");
+    EXPECT_EQ(byBytes[0].bytes, 400000u);
+}
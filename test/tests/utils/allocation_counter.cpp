@@ -0,0 +1,59 @@
+#include "allocation_counter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local std::uint64_t threadCount = 0;
+    std::atomic<std::uint64_t> totalCount(0);
+
+    void *countedAllocate(std::size_t size) {
+        ++threadCount;
+        totalCount.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1);
+    }
+}
+
+std::uint64_t AllocationCounter::threadAllocations() {
+    return threadCount;
+}
+
+std::uint64_t AllocationCounter::totalAllocations() {
+    return totalCount.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size) {
+    void *pointer = countedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new[](std::size_t size) {
+    void *pointer = countedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+// Counts calls to the global operator new made by the test binary, which
+// replaces it in allocation_counter.cpp.
+class AllocationCounter {
+public:
+    // Allocations made so far by the calling thread.
+    static std::uint64_t threadAllocations();
+
+    // Allocations made so far by all threads.
+    static std::uint64_t totalAllocations();
+};
+
+// Allocations made by the current thread since construction.
+class AllocationScope {
+public:
+    AllocationScope() : m_start(AllocationCounter::threadAllocations()) {}
+
+    std::uint64_t allocations() const {
+        return AllocationCounter::threadAllocations() - m_start;
+    }
+
+private:
+    std::uint64_t m_start;
+};
@@ -37,7 +37,8 @@ void TestUtils::cleanupLogFiles() {
         "test_log.txt", "level_test_log.txt", "rate_limit_test_log.txt",
         "escaped_brackets_test.txt", "test_log1.txt", "test_log2.txt",
         "validation_test_log.txt", "custom_formatter_log.txt", "json_formatter_log.txt", "xml_formatter_log.txt",
-        "context_test_log.txt", "default_formatter_log.txt"
+        "context_test_log.txt", "default_formatter_log.txt", "static_sink_log.txt", "binary_log.bin", "binary_log2.bin", "msgpack_log.bin", "columnar_log.bin", "framed_log.bin",
+        "index_log.txt", "index_log.txt.idx"
     };
 
     for (const auto &filename : filesToRemove) {
@@ -45,6 +46,20 @@ void TestUtils::cleanupLogFiles() {
     }
 }
 
+minta::MemorySink *TestUtils::addMemorySink(minta::LunarLog &logger, minta::SinkId *id, minta::LogLevel level,
+                                            size_t capacity) {
+    auto sink = minta::make_unique<minta::MemorySink>(capacity);
+    minta::MemorySink *memory = sink.get();
+    minta::SinkId sinkId = logger.addCustomSink(std::move(sink));
+    if (level != minta::LogLevel::TRACE) {
+        logger.setSinkMinLevel(sinkId, level);
+    }
+    if (id) {
+        *id = sinkId;
+    }
+    return memory;
+}
+
 bool TestUtils::fileExists(const std::string &filename) {
 #if __cplusplus >= 201703L
     return fs::exists(filename);
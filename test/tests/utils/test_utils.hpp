@@ -1,5 +1,6 @@
 #pragma once
 
+#include "lunar_log.hpp"
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -9,6 +10,9 @@ public:
     static std::string readLogFile(const std::string &filename);
     static void waitForFileContent(const std::string &filename, int maxAttempts = 10);
     static void cleanupLogFiles();
+    // Adds a MemorySink to the logger and returns it; the logger owns the sink.
+    static minta::MemorySink *addMemorySink(minta::LunarLog &logger, minta::SinkId *id = nullptr,
+                                            minta::LogLevel level = minta::LogLevel::TRACE, size_t capacity = 4096);
 
 private:
     static bool fileExists(const std::string &filename);
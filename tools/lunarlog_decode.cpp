@@ -0,0 +1,69 @@
+// Converts files written by BinaryFileSink back into text using the
+// built-in formatters.
+//
+//   lunarlog-decode [--format=human|json|xml] <file>...
+
+#include "lunar_log.hpp"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    std::unique_ptr<minta::IFormatter> makeFormatter(const std::string &name) {
+        if (name == "human") return minta::make_unique<minta::HumanReadableFormatter>();
+        if (name == "json") return minta::make_unique<minta::JsonFormatter>();
+        if (name == "xml") return minta::make_unique<minta::XmlFormatter>();
+        return nullptr;
+    }
+
+    int usage() {
+        std::cerr << "usage: lunarlog-decode [--format=human|json|xml] <file>...\n";
+        return 2;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string formatName = "human";
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 9, "--format=") == 0) {
+            formatName = arg.substr(9);
+        } else if (!arg.empty() && arg[0] == '-') {
+            return usage();
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    std::unique_ptr<minta::IFormatter> formatter = makeFormatter(formatName);
+    if (!formatter || files.empty()) {
+        return usage();
+    }
+
+    int status = 0;
+    minta::LogEntry entry;
+    for (const auto &filename : files) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "lunarlog-decode: cannot open " << filename << "\n";
+            status = 1;
+            continue;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        const std::string data = contents.str();
+
+        minta::BinaryLogReader reader(data.data(), data.size());
+        while (reader.next(entry)) {
+            std::cout << formatter->format(entry) << '\n';
+        }
+        if (!reader.error().empty()) {
+            std::cerr << "lunarlog-decode: " << filename << ": " << reader.error() << "\n";
+            status = 1;
+        }
+    }
+    return status;
+}
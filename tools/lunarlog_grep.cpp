@@ -0,0 +1,97 @@
+// Filters LunarLog text files (human-readable, JSON or XML output) by level,
+// time range, message template and context, scanning memory-mapped files in
+// parallel chunks.
+//
+//   lunarlog-grep [--level=WARN] [--from="YYYY-MM-DD HH:MM:SS"] [--to="..."]
+//                 [--template="User {name} logged in"] [--context=key[=value]]
+//                 [--threads=N] [--count] <file>...
+
+#include "lunar_log.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    int usage() {
+        std::cerr << "usage: lunarlog-grep [--level=LEVEL] [--from=TIME] [--to=TIME] [--template=TEMPLATE]\n"
+                     "                     [--context=KEY[=VALUE]] [--threads=N] [--count] <file>...\n";
+        return 2;
+    }
+
+    bool startsWith(const std::string &arg, const char *prefix) {
+        return arg.compare(0, std::strlen(prefix), prefix) == 0;
+    }
+
+    bool parseTime(const std::string &text, bool upperBound, int64_t &time) {
+        minta::TimestampParser parser;
+        if (!parser.parse(text.data(), text.size(), time)) {
+            return false;
+        }
+        if (upperBound && text.size() < minta::timestampTextLength()) {
+            time += 999999999;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    minta::LogQuery query;
+    unsigned threads = 0;
+    bool countOnly = false;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (startsWith(arg, "--level=")) {
+            std::string level = arg.substr(8);
+            if (!minta::parseLevelString(level.data(), level.size(), query.minLevel)) return usage();
+        } else if (startsWith(arg, "--from=")) {
+            if (!parseTime(arg.substr(7), false, query.from)) return usage();
+        } else if (startsWith(arg, "--to=")) {
+            if (!parseTime(arg.substr(5), true, query.to)) return usage();
+        } else if (startsWith(arg, "--template=")) {
+            query.messageTemplate = arg.substr(11);
+        } else if (startsWith(arg, "--context=")) {
+            std::string context = arg.substr(10);
+            size_t equals = context.find('=');
+            query.contextKey = context.substr(0, equals);
+            if (equals != std::string::npos) query.contextValue = context.substr(equals + 1);
+        } else if (startsWith(arg, "--threads=")) {
+            threads = static_cast<unsigned>(std::atoi(arg.c_str() + 10));
+        } else if (arg == "--count") {
+            countOnly = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            return usage();
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        return usage();
+    }
+
+    minta::LogLineFilter filter(query);
+    int status = 0;
+    for (const auto &filename : files) {
+        minta::MappedFile file(filename);
+        if (!file.isOpen()) {
+            std::cerr << "lunarlog-grep: cannot open " << filename << "\n";
+            status = 1;
+            continue;
+        }
+        size_t matches = minta::scanLines(file.data(), file.size(), filter, [&](const char *line, size_t length) {
+            if (!countOnly) {
+                if (files.size() > 1) std::fprintf(stdout, "%s:", filename.c_str());
+                std::fwrite(line, 1, length, stdout);
+                std::fputc('\n', stdout);
+            }
+        }, threads);
+        if (countOnly) {
+            std::fprintf(stdout, "%s%s%zu\n", files.size() > 1 ? filename.c_str() : "", files.size() > 1 ? ":" : "", matches);
+        }
+    }
+    return status;
+}
@@ -0,0 +1,74 @@
+// Merges LunarLog files (human-readable, JSON, XML or binary) into one stream
+// ordered by timestamp, written with one of the built-in formatters.
+//
+//   lunarlog-merge [--format=human|json|xml] <file>...
+
+#include "lunar_log.hpp"
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    std::unique_ptr<minta::IFormatter> makeFormatter(const std::string &name) {
+        if (name == "human") return minta::make_unique<minta::HumanReadableFormatter>();
+        if (name == "json") return minta::make_unique<minta::JsonFormatter>();
+        if (name == "xml") return minta::make_unique<minta::XmlFormatter>();
+        return nullptr;
+    }
+
+    int usage() {
+        std::cerr << "usage: lunarlog-merge [--format=human|json|xml] <file>...\n";
+        return 2;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::string formatName = "human";
+    std::vector<std::string> filenames;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 9, "--format=") == 0) {
+            formatName = arg.substr(9);
+        } else if (!arg.empty() && arg[0] == '-') {
+            return usage();
+        } else {
+            filenames.push_back(arg);
+        }
+    }
+
+    std::unique_ptr<minta::IFormatter> formatter = makeFormatter(formatName);
+    if (!formatter || filenames.empty()) {
+        return usage();
+    }
+
+    int status = 0;
+    std::vector<std::unique_ptr<minta::MappedFile>> files;
+    minta::LogMerger merger;
+    for (const auto &filename : filenames) {
+        std::unique_ptr<minta::MappedFile> file = minta::make_unique<minta::MappedFile>(filename);
+        if (!file->isOpen()) {
+            std::cerr << "lunarlog-merge: cannot open " << filename << "\n";
+            status = 1;
+            continue;
+        }
+        merger.addInput(file->data(), file->size());
+        files.push_back(std::move(file));
+    }
+
+    std::string line;
+    merger.merge([&](const minta::LogEntry &entry, size_t) {
+        line.clear();
+        formatter->formatTo(entry, line);
+        line += '\n';
+        std::fwrite(line.data(), 1, line.size(), stdout);
+    });
+    if (merger.skipped() > 0) {
+        std::cerr << "lunarlog-merge: skipped " << merger.skipped() << " undecodable lines or records\n";
+    }
+    if (merger.outOfOrder() > 0) {
+        std::cerr << "lunarlog-merge: " << merger.outOfOrder() << " entries were too far out of order to sort\n";
+    }
+    return status;
+}
@@ -0,0 +1,49 @@
+// Prints the lines of a LunarLog text file (human-readable, JSON or XML) that
+// fall inside a time range, using the sparse index written by FileSink with
+// FileIndexOptions to read only the relevant part of the file.
+//
+//   lunarlog-range <logfile> "<from>" "<to>"
+//
+// Times are local, "YYYY-MM-DD HH:MM:SS" with optional ".mmm".
+
+#include "lunar_log.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char **argv) {
+    if (argc != 4) {
+        std::cerr << "usage: lunarlog-range <logfile> \"YYYY-MM-DD HH:MM:SS[.mmm]\" \"YYYY-MM-DD HH:MM:SS[.mmm]\"\n";
+        return 2;
+    }
+
+    minta::TimestampParser parser;
+    int64_t from, to;
+    if (!parser.parse(argv[2], std::strlen(argv[2]), from) || !parser.parse(argv[3], std::strlen(argv[3]), to)) {
+        std::cerr << "lunarlog-range: invalid time\n";
+        return 2;
+    }
+    if (std::strlen(argv[3]) < minta::timestampTextLength()) {
+        to += 999999999;
+    }
+
+    const std::string logPath = argv[1];
+    minta::MappedFile log(logPath);
+    if (!log.isOpen()) {
+        std::cerr << "lunarlog-range: cannot open " << logPath << "\n";
+        return 1;
+    }
+
+    minta::MappedFile indexFile(logPath + ".idx");
+    minta::FileIndex index(indexFile.data(), indexFile.size());
+    if (!index.valid()) {
+        std::cerr << "lunarlog-range: no index for " << logPath << ", scanning the whole file\n";
+    }
+
+    index.forEachLineInRange(log.data(), log.size(), from, to, [](const char *line, size_t length) {
+        std::fwrite(line, 1, length, stdout);
+        std::fputc('\n', stdout);
+    });
+    return 0;
+}